@@ -0,0 +1,1003 @@
+﻿/**
+ * @file benchmarks.cpp
+ * @brief Реализация замеров производительности операций над деревьями
+ */
+
+#include "benchmarks.h"
+#include "data_generator.h"
+#include "key_source.h"
+#include "perf_counters.h"
+#include "huge_page_arena.h"
+#include "workload.h"
+#include "tree_builders.h"
+#include "tree_properties.h"
+#include "tree_traversal.h"
+#include "tree_snapshot.h"
+#include "succinct_tree.h"
+#include "static_index.h"
+#include "concurrent_avl.h"
+#include "epoch_reclamation.h"
+#include "node_memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Фиксированное зерно: замеры повторяются на одних и тех же данных
+static const unsigned long long BENCHMARK_SEED = 20250101;
+
+ /**
+  * @brief Время выполнения функции в наносекундах
+  * @param action Замеряемое действие
+  */
+template <typename Action>
+static double measureNanoseconds(Action action) {
+    auto start = std::chrono::steady_clock::now();
+    action();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - start).count();
+}
+
+/**
+ * @brief Сравнение поиска по одному ключу и пакетного поиска
+ * @param sizes Размеры деревьев
+ * @param probeCount Количество ключей поиска для каждого дерева
+ *
+ * @details
+ * Для каждого размера строится СДП из случайных ключей. Половина ключей поиска
+ * берется из дерева, половина - заведомо отсутствует (четные ключи при нечетных
+ * ключах дерева). Ключи поиска перемешаны, поэтому каждый поиск в большом дереве
+ * упирается в промахи кэша.
+ */
+static void compareLookupThroughput(const std::vector<int>& sizes, int probeCount) {
+    std::cout << "=== ПОИСК: ПО ОДНОМУ КЛЮЧУ И ПАКЕТОМ ===" << std::endl;
+    std::cout << std::setw(10) << "Размер" << " | "
+        << std::setw(16) << "searchNode" << " | "
+        << std::setw(16) << "searchBatch" << " | "
+        << std::setw(10) << "Ускорение" << std::endl;
+    std::cout << std::setw(10) << "" << " | "
+        << std::setw(16) << "нс/поиск" << " | "
+        << std::setw(16) << "нс/поиск" << " | "
+        << std::setw(10) << "" << std::endl;
+    std::cout << std::string(62, '-') << std::endl;
+
+    for (int size : sizes) {
+        // Нечетные ключи в дереве, четные - промахи
+        std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+        for (int& key : data) key |= 1;
+        TreeNode* tree = TreeBuilders::buildRandomSearchTree(data);
+
+        std::vector<int> probes = DataGenerator::generateUniqueNumbers(probeCount, 0, probeCount * 4, BENCHMARK_SEED + 1);
+        for (size_t i = 0; i < probes.size(); i++) {
+            probes[i] = (i % 2 == 0) ? data[probes[i] % data.size()] : (probes[i] & ~1);
+        }
+
+        size_t foundSingle = 0;
+        double singleNs = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (TreeProperties::searchNode(tree, key) != nullptr) foundSingle++;
+            }
+        });
+
+        std::vector<TreeNode*> results;
+        double batchNs = measureNanoseconds([&]() {
+            TreeProperties::searchBatch(tree, probes, results);
+        });
+
+        size_t foundBatch = 0;
+        for (TreeNode* node : results) {
+            if (node != nullptr) foundBatch++;
+        }
+        if (foundBatch != foundSingle) {
+            std::cerr << "Предупреждение: результаты searchBatch не совпадают с searchNode!" << std::endl;
+        }
+
+        std::cout << std::setw(10) << size << " | "
+            << std::setw(16) << std::fixed << std::setprecision(1) << singleNs / probes.size() << " | "
+            << std::setw(16) << std::fixed << std::setprecision(1) << batchNs / probes.size() << " | "
+            << std::setw(9) << std::fixed << std::setprecision(2) << singleNs / batchNs << "x" << std::endl;
+
+        TreeBuilders::deleteTree(tree);
+    }
+
+    std::cout << std::string(62, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Сравнение поиска отсортированного пакета по одному ключу и за один спуск
+ * @param size Размер деревьев
+ * @param batchSizes Размеры пакетов ключей поиска
+ *
+ * @details
+ * Пакет ключей отсортирован (как при соединении с отсортированным входом).
+ * Для СДП и ДБД (t=2) сравнивается цикл поисков от корня с searchSortedBatch,
+ * который проходит общие части путей один раз.
+ */
+static void compareSortedBatchLookup(int size, const std::vector<int>& batchSizes) {
+    std::cout << "=== ПОИСК ОТСОРТИРОВАННОГО ПАКЕТА (" << size << " ключей) ===" << std::endl;
+    std::cout << std::setw(10) << "Пакет" << " | "
+        << std::setw(12) << "СДП цикл" << std::setw(12) << "СДП пакет" << " | "
+        << std::setw(12) << "ДБД цикл" << std::setw(12) << "ДБД пакет" << std::endl;
+    std::cout << std::setw(10) << "" << " | "
+        << std::setw(24) << "нс/поиск" << " | "
+        << std::setw(24) << "нс/поиск" << std::endl;
+    std::cout << std::string(70, '-') << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+    TreeNode* tree = TreeBuilders::buildRandomSearchTree(data);
+    DBNode* dbTree = TreeBuilders::buildDBTree(data, 2);
+
+    for (int batchSize : batchSizes) {
+        std::vector<int> probes = DataGenerator::generateUniqueNumbers(batchSize, 0, size * 4, BENCHMARK_SEED + 1);
+        std::sort(probes.begin(), probes.end());
+
+        size_t found = 0;
+        double loopNs = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (TreeProperties::searchNode(tree, key) != nullptr) found++;
+            }
+        });
+        std::vector<TreeNode*> results;
+        double batchNs = measureNanoseconds([&]() {
+            TreeProperties::searchSortedBatch(tree, probes, results);
+        });
+
+        double loopDBNs = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (TreeProperties::searchNodeDB(dbTree, key) != nullptr) found++;
+            }
+        });
+        std::vector<DBNode*> resultsDB;
+        double batchDBNs = measureNanoseconds([&]() {
+            TreeProperties::searchSortedBatchDB(dbTree, probes, resultsDB);
+        });
+
+        std::cout << std::setw(10) << batchSize << " | " << std::fixed << std::setprecision(1)
+            << std::setw(12) << loopNs / batchSize << std::setw(12) << batchNs / batchSize << " | "
+            << std::setw(12) << loopDBNs / batchSize << std::setw(12) << batchDBNs / batchSize << std::endl;
+    }
+
+    TreeBuilders::deleteTree(tree);
+    TreeBuilders::deleteDBTree(dbTree);
+
+    std::cout << std::string(70, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Построение и поиск при разных формах входных данных
+ * @param buildSize Размер деревьев для замера построения
+ * @param lookupSize Размер АВЛ-дерева для замера поиска
+ * @param probeCount Количество ключей поиска
+ *
+ * @details
+ * Первая таблица: время построения СДП, АВЛ и ДБД и их высоты для каждой
+ * формы с уникальными ключами. Размер построения небольшой: на отсортированных
+ * данных СДП вырождается в список и строится за O(n^2).
+ * Вторая таблица: поиск в АВЛ-дереве потоком запросов каждой формы; форма
+ * задает индексы в отсортированном массиве ключей дерева.
+ */
+static void compareInputDistributions(int buildSize, int lookupSize, int probeCount) {
+    std::cout << "=== ПОСТРОЕНИЕ ПРИ РАЗНЫХ ФОРМАХ ДАННЫХ (" << buildSize << " ключей) ===" << std::endl;
+    std::cout << std::setw(24) << "Форма" << " | "
+        << std::setw(30) << "нс/ключ: СДП    АВЛ    ДБД" << " | "
+        << std::setw(24) << "высота: СДП  АВЛ  ДБД" << std::endl;
+    std::cout << std::string(86, '-') << std::endl;
+
+    for (KeyDistribution distribution : DataGenerator::buildDistributions()) {
+        std::vector<int> data = DataGenerator::generateKeys(distribution, buildSize, 0, buildSize * 4, BENCHMARK_SEED);
+
+        TreeNode* spTree = nullptr;
+        TreeNode* avlTree = nullptr;
+        DBNode* dbTree = nullptr;
+        double spNs = measureNanoseconds([&]() { spTree = TreeBuilders::buildRandomSearchTree(data); });
+        double avlNs = measureNanoseconds([&]() { avlTree = TreeBuilders::buildAVLTree(data); });
+        double dbNs = measureNanoseconds([&]() { dbTree = TreeBuilders::buildDBTree(data, 2); });
+
+        std::cout << std::setw(24) << DataGenerator::distributionName(distribution) << " | "
+            << std::fixed << std::setprecision(1)
+            << std::setw(10) << spNs / buildSize << std::setw(10) << avlNs / buildSize
+            << std::setw(10) << dbNs / buildSize << " | "
+            << std::setw(12) << TreeProperties::calculateHeight(spTree)
+            << std::setw(6) << TreeProperties::calculateHeight(avlTree)
+            << std::setw(6) << TreeProperties::calculateStatsDB(dbTree).height << std::endl;
+
+        TreeBuilders::deleteTree(spTree);
+        TreeBuilders::deleteTree(avlTree);
+        TreeBuilders::deleteDBTree(dbTree);
+    }
+    std::cout << std::string(86, '=') << std::endl << std::endl;
+
+    std::cout << "=== ПОИСК В АВЛ ПРИ РАЗНЫХ ФОРМАХ ЗАПРОСОВ (" << lookupSize << " ключей) ===" << std::endl;
+    std::cout << std::setw(24) << "Форма" << " | " << std::setw(12) << "нс/поиск" << std::endl;
+    std::cout << std::string(40, '-') << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(lookupSize, 0, lookupSize * 4, BENCHMARK_SEED);
+    TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
+    std::sort(data.begin(), data.end());
+
+    for (KeyDistribution distribution : DataGenerator::allDistributions()) {
+        std::vector<int> probes = DataGenerator::generateKeys(distribution, probeCount, 0, lookupSize - 1, BENCHMARK_SEED + 1);
+        for (int& probe : probes) probe = data[probe];
+
+        size_t found = 0;
+        double ns = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (TreeProperties::searchNode(avlTree, key) != nullptr) found++;
+            }
+        });
+        if (found != probes.size()) {
+            std::cerr << "Предупреждение: часть ключей не найдена в АВЛ-дереве!" << std::endl;
+        }
+
+        std::cout << std::setw(24) << DataGenerator::distributionName(distribution) << " | "
+            << std::fixed << std::setprecision(1) << std::setw(12) << ns / probes.size() << std::endl;
+    }
+
+    TreeBuilders::deleteTree(avlTree);
+    std::cout << std::string(40, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Построение АВЛ-дерева из вектора и из потоковых источников
+ * @param size Количество ключей
+ *
+ * @details
+ * Время включает генерацию ключей. Из вектора все ключи материализуются
+ * до построения; из генератора в памяти одна порция; с предвыборкой
+ * следующая порция генерируется параллельно со вставками текущей.
+ */
+static void compareStreamingBuild(int size) {
+    std::cout << "=== ПОСТРОЕНИЕ АВЛ ИЗ ПОТОКА (" << size << " ключей) ===" << std::endl;
+    std::cout << std::setw(24) << "Источник" << " | " << std::setw(10) << "мс"
+        << " | " << std::setw(16) << "память ключей" << std::endl;
+    std::cout << std::string(58, '-') << std::endl;
+
+    TreeDigest vectorDigest, generatedDigest, prefetchDigest;
+    TreeNode* tree = nullptr;
+
+    double vectorNs = measureNanoseconds([&]() {
+        std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+        tree = TreeBuilders::buildAVLTree(data, &vectorDigest);
+    });
+    TreeBuilders::deleteTree(tree);
+
+    double generatedNs = measureNanoseconds([&]() {
+        GeneratedKeySource source(size, 0, size * 4, BENCHMARK_SEED);
+        tree = TreeBuilders::buildAVLTree(source, &generatedDigest);
+    });
+    TreeBuilders::deleteTree(tree);
+
+    double prefetchNs = measureNanoseconds([&]() {
+        GeneratedKeySource source(size, 0, size * 4, BENCHMARK_SEED);
+        PrefetchingKeySource prefetching(source);
+        tree = TreeBuilders::buildAVLTree(prefetching, &prefetchDigest);
+    });
+    TreeBuilders::deleteTree(tree);
+
+    if (generatedDigest != vectorDigest || prefetchDigest != vectorDigest) {
+        std::cerr << "Предупреждение: деревья из потока и из вектора различаются!" << std::endl;
+    }
+
+    size_t chunkBytes = KeySource::DEFAULT_CHUNK_SIZE * sizeof(int);
+    std::cout << std::fixed << std::setprecision(1)
+        << std::setw(24) << "вектор" << " | " << std::setw(10) << vectorNs / 1e6
+        << " | " << std::setw(13) << size * sizeof(int) / 1024 << " КБ" << std::endl
+        << std::setw(24) << "генератор" << " | " << std::setw(10) << generatedNs / 1e6
+        << " | " << std::setw(13) << chunkBytes / 1024 << " КБ" << std::endl
+        << std::setw(24) << "генератор + предвыборка" << " | " << std::setw(10) << prefetchNs / 1e6
+        << " | " << std::setw(13) << 2 * chunkBytes / 1024 << " КБ" << std::endl;
+    std::cout << std::string(58, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Воспроизведение смешанных трасс на всех видах деревьев
+ * @param initialKeys Ключей до начала операций
+ * @param operationCount Операций в трассе
+ *
+ * @details
+ * Для каждой смеси генерируется одна трасса с ключами по Ципфу,
+ * сохраняется в файл и загружается обратно, затем воспроизводится на
+ * каждом виде дерева. Задержки - медиана / 99-й перцентиль, нс.
+ */
+static void compareWorkloadReplay(int initialKeys, int operationCount) {
+    struct NamedMix {
+        const char* name;
+        WorkloadMix mix;
+    };
+    const NamedMix mixes[] = {
+        { "чтение 95/5", { 5, 95, 0, 0 } },
+        { "обновление 50/50", { 25, 50, 25, 0 } },
+        { "диапазоны 95/5", { 5, 0, 0, 95 } },
+    };
+
+    std::cout << "=== СМЕШАННЫЕ ТРАССЫ (" << initialKeys << " ключей, "
+        << operationCount << " операций, Ципф) ===" << std::endl;
+    std::cout << std::setw(18) << "Смесь" << " | " << std::setw(6) << "Дерево" << " | "
+        << std::setw(10) << "тыс. оп/с";
+    for (int type = 0; type < OPERATION_TYPE_COUNT; type++) {
+        std::cout << " | " << std::setw(13) << Workload::operationName(static_cast<OperationType>(type));
+    }
+    std::cout << std::endl << std::string(110, '-') << std::endl;
+
+    const std::string path = "benchmark_trace.bin";
+    for (const NamedMix& named : mixes) {
+        WorkloadSpec spec;
+        spec.initialKeys = initialKeys;
+        spec.operationCount = operationCount;
+        spec.mix = named.mix;
+        spec.distribution = KeyDistribution::Zipf;
+        spec.seed = BENCHMARK_SEED;
+
+        Trace trace;
+        long long bytes = Workload::save(Workload::generate(spec), path);
+        if (bytes < 0 || !Workload::load(path, trace)) continue;
+        std::remove(path.c_str());
+
+        for (TreeKind kind : { TreeKind::PerfectlyBalanced, TreeKind::RandomSearch, TreeKind::AVL, TreeKind::DB }) {
+            ReplayResult result = Workload::replay(trace, kind);
+            std::cout << std::setw(18) << named.name << " | " << std::setw(6) << Workload::treeKindName(kind)
+                << " | " << std::fixed << std::setprecision(1) << std::setw(10) << result.operationsPerSecond / 1000;
+            for (const OperationLatency& latency : result.latency) {
+                if (latency.count == 0) {
+                    std::cout << " | " << std::setw(13) << "-";
+                }
+                else {
+                    std::cout << " | " << std::setprecision(0) << std::setw(6) << latency.p50Ns
+                        << " /" << std::setw(6) << latency.p99Ns;
+                }
+            }
+            std::cout << std::endl;
+        }
+        std::cout << std::setw(18) << "" << "   трасса: " << std::setprecision(2)
+            << static_cast<double>(bytes) / operationCount << " байт/операция" << std::endl;
+    }
+    std::cout << std::string(110, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Вывод строки аппаратных счетчиков на ключ
+ * @param tree Название дерева
+ * @param region Название замеренного участка
+ * @param reading Значения счетчиков
+ * @param keys Ключей (операций) в участке
+ */
+static void printPerfRow(const char* tree, const char* region, const PerfReading& reading, long long keys) {
+    std::cout << std::setw(6) << tree << " | " << std::setw(10) << region;
+    std::cout << std::fixed << std::setprecision(2);
+    for (int event = 0; event < PERF_EVENT_COUNT; event++) {
+        double value = reading.perKey(static_cast<PerfEvent>(event), keys);
+        std::cout << " | " << std::setw(12);
+        if (value < 0) std::cout << "н/д";
+        else std::cout << value;
+    }
+    if (reading.available(PerfEvent::Cycles) && reading.available(PerfEvent::Instructions)
+        && reading.values[static_cast<int>(PerfEvent::Cycles)] > 0) {
+        std::cout << " | " << std::setw(5) << static_cast<double>(reading.values[static_cast<int>(PerfEvent::Instructions)])
+            / reading.values[static_cast<int>(PerfEvent::Cycles)];
+    }
+    else {
+        std::cout << " | " << std::setw(5) << "н/д";
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Аппаратные счетчики на ключ для построения и поиска
+ * @param size Количество ключей в дереве
+ * @param probeCount Количество ключей поиска
+ *
+ * @details
+ * Для каждого вида дерева отдельно замеряются построение (на вставленный
+ * ключ) и поиск существующих ключей в случайном порядке (на поиск).
+ * Промахи L1D/LLC/dTLB на ключ, сравнимые с высотой дерева, означают,
+ * что почти каждый шаг спуска ждет память. IPC - инструкций за такт.
+ * Если ядро не дает открыть счетчики, выводится предупреждение.
+ */
+static void compareHardwareCounters(int size, int probeCount) {
+    std::cout << "=== АППАРАТНЫЕ СЧЕТЧИКИ НА КЛЮЧ (" << size << " ключей, "
+        << probeCount << " поисков) ===" << std::endl;
+
+    PerfCounters counters;
+    if (!counters.isAvailable()) {
+        std::cout << "Счетчики perf_event_open недоступны (не Linux, perf_event_paranoid"
+            << " или нет PMU) - замер пропущен" << std::endl << std::endl;
+        return;
+    }
+
+    std::cout << std::setw(6) << "Дерево" << " | " << std::setw(10) << "Участок";
+    for (int event = 0; event < PERF_EVENT_COUNT; event++) {
+        std::cout << " | " << std::setw(12) << PerfCounters::eventName(static_cast<PerfEvent>(event));
+    }
+    std::cout << " | " << std::setw(5) << "IPC" << std::endl;
+    std::cout << std::string(118, '-') << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+    std::vector<int> sortedData = data;
+    std::sort(sortedData.begin(), sortedData.end());
+    std::vector<int> probes = DataGenerator::generateRandomNumbers(probeCount, 0, size - 1, BENCHMARK_SEED + 1);
+    for (int& probe : probes) probe = data[probe];
+
+    size_t found = 0;
+    auto lookupTree = [&](TreeNode* tree) {
+        return counters.measure([&]() {
+            for (int key : probes) {
+                if (TreeProperties::searchNode(tree, key) != nullptr) found++;
+            }
+        });
+    };
+
+    TreeNode* tree = nullptr;
+    PerfReading build = counters.measure([&]() { tree = TreeBuilders::buildPerfectlyBalancedTree(sortedData); });
+    printPerfRow("ИСДП", "построение", build, size);
+    printPerfRow("ИСДП", "поиск", lookupTree(tree), probeCount);
+    TreeBuilders::deleteTree(tree);
+
+    build = counters.measure([&]() { tree = TreeBuilders::buildRandomSearchTree(data); });
+    printPerfRow("СДП", "построение", build, size);
+    printPerfRow("СДП", "поиск", lookupTree(tree), probeCount);
+    TreeBuilders::deleteTree(tree);
+
+    build = counters.measure([&]() { tree = TreeBuilders::buildAVLTree(data); });
+    printPerfRow("АВЛ", "построение", build, size);
+    printPerfRow("АВЛ", "поиск", lookupTree(tree), probeCount);
+    TreeBuilders::deleteTree(tree);
+
+    DBNode* dbTree = nullptr;
+    build = counters.measure([&]() { dbTree = TreeBuilders::buildDBTree(data, 2); });
+    printPerfRow("ДБД", "построение", build, size);
+    PerfReading lookup = counters.measure([&]() {
+        for (int key : probes) {
+            if (TreeProperties::searchNodeDB(dbTree, key) != nullptr) found++;
+        }
+    });
+    printPerfRow("ДБД", "поиск", lookup, probeCount);
+    TreeBuilders::deleteDBTree(dbTree);
+
+    if (found != 4 * probes.size()) {
+        std::cerr << "Предупреждение: часть ключей не найдена при замере счетчиков!" << std::endl;
+    }
+    std::cout << std::string(118, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Узлы из кучи и из арены на больших страницах
+ * @param size Количество ключей в АВЛ-дереве
+ * @param probeCount Количество ключей поиска
+ *
+ * @details
+ * Одно и то же АВЛ-дерево строится дважды: с узлами из кучи и с узлами
+ * из HugePageArena. Поиск идет по случайным существующим ключам, поэтому
+ * почти каждый шаг спуска касается новой страницы. Промахи dTLB на поиск
+ * выводятся, если доступны аппаратные счетчики. Состояние арены после
+ * замера восстанавливается.
+ */
+static void compareHugePages(int size, int probeCount) {
+    std::cout << "=== УЗЛЫ НА БОЛЬШИХ СТРАНИЦАХ (АВЛ, " << size << " ключей) ===" << std::endl;
+    std::cout << std::setw(18) << "Память узлов" << " | " << std::setw(12) << "нс/вставка"
+        << " | " << std::setw(12) << "нс/поиск" << " | " << std::setw(14) << "dTLB/поиск" << std::endl;
+    std::cout << std::string(66, '-') << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+    std::vector<int> probes = DataGenerator::generateRandomNumbers(probeCount, 0, size - 1, BENCHMARK_SEED + 1);
+    for (int& probe : probes) probe = data[probe];
+
+    bool wasEnabled = HugePageArena::isEnabled();
+    PerfCounters counters;
+    for (bool huge : { false, true }) {
+        if (!huge) {
+            HugePageArena::disable();
+        }
+        else if (!HugePageArena::enable()) {
+            std::cout << std::setw(18) << "большие страницы" << " | арена недоступна на этой платформе" << std::endl;
+            break;
+        }
+
+        TreeNode* tree = nullptr;
+        double buildNs = measureNanoseconds([&]() { tree = TreeBuilders::buildAVLTree(data); });
+
+        size_t found = 0;
+        PerfReading reading;
+        double lookupNs = measureNanoseconds([&]() {
+            reading = counters.measure([&]() {
+                for (int key : probes) {
+                    if (TreeProperties::searchNode(tree, key) != nullptr) found++;
+                }
+            });
+        });
+        if (found != probes.size()) {
+            std::cerr << "Предупреждение: часть ключей не найдена в АВЛ-дереве!" << std::endl;
+        }
+
+        std::cout << std::setw(18) << (huge ? "большие страницы" : "куча") << " | "
+            << std::fixed << std::setprecision(1) << std::setw(12) << buildNs / size << " | "
+            << std::setw(12) << lookupNs / probes.size() << " | " << std::setw(14);
+        double misses = reading.perKey(PerfEvent::DTLBMisses, probeCount);
+        if (misses < 0) std::cout << "н/д";
+        else std::cout << std::setprecision(2) << misses;
+        std::cout << std::endl;
+
+        TreeBuilders::deleteTree(tree);
+    }
+    if (HugePageArena::usedBytes() > 0) {
+        std::cout << "Арена: " << HugePageArena::usedBytes() / (1 << 20) << " МиБ, madvise(MADV_HUGEPAGE) "
+            << (HugePageArena::hugePagesAdvised() ? "принят" : "не принят") << std::endl;
+    }
+
+    if (wasEnabled) HugePageArena::enable();
+    else HugePageArena::disable();
+    std::cout << std::string(66, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Построение из ключей против загрузки снимка
+ * @param size Количество ключей
+ *
+ * @details
+ * Построение АВЛ и ДБД (t = 2) из случайных ключей сравнивается
+ * с загрузкой их снимков: загрузка не сравнивает ключи и не балансирует.
+ */
+static void compareSnapshotLoad(int size) {
+    std::cout << "=== ЗАГРУЗКА СНИМКА ВМЕСТО ПОСТРОЕНИЯ (" << size << " ключей) ===" << std::endl;
+    std::cout << std::setw(8) << "Дерево" << " | " << std::setw(14) << "построение, мс"
+        << " | " << std::setw(12) << "запись, мс" << " | " << std::setw(14) << "загрузка, мс"
+        << " | " << std::setw(12) << "байт/ключ" << std::endl;
+    std::cout << std::string(72, '-') << std::endl;
+
+    const std::string path = "snapshot_benchmark.bin";
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+
+    auto printRow = [&](const char* tree, double buildNs, double saveNs, double loadNs, long long bytes) {
+        std::cout << std::fixed << std::setprecision(1)
+            << std::setw(8) << tree << " | " << std::setw(14) << buildNs / 1e6
+            << " | " << std::setw(12) << saveNs / 1e6 << " | " << std::setw(14) << loadNs / 1e6
+            << " | " << std::setw(12) << std::setprecision(2) << static_cast<double>(bytes) / size << std::endl;
+    };
+
+    TreeDigest builtDigest, loadedDigest;
+    TreeNode* avlTree = nullptr;
+    TreeNode* loadedAVL = nullptr;
+    long long bytes = -1;
+    double buildNs = measureNanoseconds([&]() { avlTree = TreeBuilders::buildAVLTree(data, &builtDigest); });
+    double saveNs = measureNanoseconds([&]() { bytes = TreeSnapshot::save(avlTree, path); });
+    double loadNs = measureNanoseconds([&]() { TreeSnapshot::load(path, loadedAVL, &loadedDigest); });
+    if (loadedDigest != builtDigest) {
+        std::cerr << "Предупреждение: загруженное АВЛ-дерево отличается от построенного!" << std::endl;
+    }
+    printRow("АВЛ", buildNs, saveNs, loadNs, bytes);
+    TreeBuilders::deleteTree(avlTree);
+    TreeBuilders::deleteTree(loadedAVL);
+
+    builtDigest = TreeDigest();
+    loadedDigest = TreeDigest();
+    DBNode* dbTree = nullptr;
+    DBNode* loadedDB = nullptr;
+    int t = 0;
+    buildNs = measureNanoseconds([&]() { dbTree = TreeBuilders::buildDBTree(data, 2, &builtDigest); });
+    saveNs = measureNanoseconds([&]() { bytes = TreeSnapshot::save(dbTree, 2, path); });
+    loadNs = measureNanoseconds([&]() { TreeSnapshot::load(path, loadedDB, t, &loadedDigest); });
+    if (loadedDigest != builtDigest) {
+        std::cerr << "Предупреждение: загруженное ДБД отличается от построенного!" << std::endl;
+    }
+    printRow("ДБД", buildNs, saveNs, loadNs, bytes);
+    TreeBuilders::deleteDBTree(dbTree);
+    TreeBuilders::deleteDBTree(loadedDB);
+
+    std::remove(path.c_str());
+    std::cout << std::string(72, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Деревья из указателей против компактного представления
+ * @param size Количество ключей
+ * @param probeCount Количество поисков
+ *
+ * @details
+ * Для ИСДП и АВЛ из одних и тех же ключей сравниваются память на ключ
+ * (узлы TreeNode по NodeMemory против формы и упакованных ключей
+ * SuccinctTree) и время поиска существующих ключей.
+ */
+static void compareSuccinctTree(int size, int probeCount) {
+    std::cout << "=== КОМПАКТНОЕ ПРЕДСТАВЛЕНИЕ (" << size << " ключей) ===" << std::endl;
+    std::cout << std::setw(22) << "Дерево" << " | " << std::setw(12) << "байт/ключ"
+        << " | " << std::setw(12) << "нс/поиск" << std::endl;
+    std::cout << std::string(52, '-') << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+    std::vector<int> probes = DataGenerator::generateRandomNumbers(probeCount, 0, size - 1, BENCHMARK_SEED + 1);
+    for (int& probe : probes) probe = data[probe];
+    std::vector<int> sortedData = data;
+    std::sort(sortedData.begin(), sortedData.end());
+
+    auto printRow = [](const std::string& tree, double bytesPerKey, double lookupNs) {
+        std::cout << std::fixed << std::setprecision(2) << std::setw(22) << tree << " | "
+            << std::setw(12) << bytesPerKey << " | " << std::setprecision(1) << std::setw(12) << lookupNs << std::endl;
+    };
+
+    for (int kind = 0; kind < 2; kind++) {
+        const std::string name = kind == 0 ? "ИСДП" : "АВЛ";
+        MemoryStats start = NodeMemory::mark();
+        TreeNode* tree = kind == 0 ? TreeBuilders::buildPerfectlyBalancedTree(sortedData)
+            : TreeBuilders::buildAVLTree(data);
+        MemoryStats memory = NodeMemory::since(start);
+
+        size_t pointerFound = 0;
+        double pointerNs = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (TreeProperties::searchNode(tree, key) != nullptr) pointerFound++;
+            }
+        });
+
+        SuccinctTree succinct(tree);
+        size_t succinctFound = 0;
+        double succinctNs = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (succinct.search(key) != SuccinctTree::NONE) succinctFound++;
+            }
+        });
+        if (pointerFound != probes.size() || succinctFound != probes.size()) {
+            std::cerr << "Предупреждение: часть ключей не найдена в " << name << "!" << std::endl;
+        }
+
+        printRow(name + " (указатели)", memory.bytesPerKey(size), pointerNs / probes.size());
+        printRow(name + " (компактно)", static_cast<double>(succinct.memoryBytes()) / size,
+            succinctNs / probes.size());
+        TreeBuilders::deleteTree(tree);
+    }
+    std::cout << std::string(52, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief ИСДП в памяти против статического индекса в файле
+ * @param size Количество ключей
+ * @param probeCount Количество поисков
+ *
+ * @details
+ * Запуск - время от отсортированных ключей (или файла) до готовности
+ * к поиску: построение ИСДП против открытия индекса. Первый поиск по
+ * только что открытому индексу еще подгружает страницы, поэтому время
+ * поиска замеряется на втором проходе.
+ */
+static void compareStaticIndex(int size, int probeCount) {
+    std::cout << "=== СТАТИЧЕСКИЙ ИНДЕКС В ФАЙЛЕ (" << size << " ключей) ===" << std::endl;
+    std::cout << std::setw(20) << "Структура" << " | " << std::setw(12) << "запуск, мс"
+        << " | " << std::setw(12) << "нс/поиск" << std::endl;
+    std::cout << std::string(50, '-') << std::endl;
+
+    const std::string path = "index_benchmark.bin";
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4, BENCHMARK_SEED);
+    std::vector<int> probes = DataGenerator::generateRandomNumbers(probeCount, 0, size - 1, BENCHMARK_SEED + 1);
+    for (int& probe : probes) probe = data[probe];
+    std::sort(data.begin(), data.end());
+
+    TreeNode* tree = nullptr;
+    double buildNs = measureNanoseconds([&]() { tree = TreeBuilders::buildPerfectlyBalancedTree(data); });
+    size_t treeFound = 0;
+    double treeNs = measureNanoseconds([&]() {
+        for (int key : probes) {
+            if (TreeProperties::searchNode(tree, key) != nullptr) treeFound++;
+        }
+    });
+
+    StaticIndex::write(tree, path);
+    TreeBuilders::deleteTree(tree);
+
+    StaticIndex index;
+    double openNs = measureNanoseconds([&]() { index.open(path); });
+    size_t indexFound = 0;
+    for (int round = 0; round < 2; round++) {
+        indexFound = 0;
+        double indexNs = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (index.contains(key)) indexFound++;
+            }
+        });
+        if (round == 1) {
+            std::cout << std::fixed << std::setprecision(1)
+                << std::setw(20) << "ИСДП в памяти" << " | " << std::setw(12) << buildNs / 1e6
+                << " | " << std::setw(12) << treeNs / probes.size() << std::endl
+                << std::setw(20) << (index.isMapped() ? "индекс (mmap)" : "индекс (чтение)") << " | "
+                << std::setw(12) << std::setprecision(3) << openNs / 1e6
+                << " | " << std::setw(12) << std::setprecision(1) << indexNs / probes.size() << std::endl;
+        }
+    }
+    if (treeFound != probes.size() || indexFound != probes.size()) {
+        std::cerr << "Предупреждение: часть ключей не найдена!" << std::endl;
+    }
+
+    index.close();
+    std::remove(path.c_str());
+    std::cout << std::string(50, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Пропускная способность нескольких потоков
+ * @param threads Число потоков
+ * @param milliseconds Длительность замера
+ * @param operation Операция потока: operation(генератор потока)
+ * @return Операций в секунду всеми потоками
+ */
+template <typename Operation>
+static double measureThroughput(int threads, int milliseconds, Operation operation) {
+    std::atomic<int> ready{ 0 };
+    std::atomic<bool> start{ false };
+    std::atomic<bool> stop{ false };
+    std::vector<long long> counts(threads, 0);
+    std::vector<std::thread> workers;
+    for (int thread = 0; thread < threads; thread++) {
+        workers.emplace_back([&, thread]() {
+            std::mt19937 random(static_cast<unsigned>(BENCHMARK_SEED + thread));
+            ready++;
+            while (!start.load()) std::this_thread::yield();
+            long long done = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                for (int i = 0; i < 64; i++) operation(random);
+                done += 64;
+            }
+            counts[thread] = done;
+        });
+    }
+    while (ready.load() < threads) std::this_thread::yield();
+
+    auto begin = std::chrono::steady_clock::now();
+    start = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+    stop = true;
+    for (std::thread& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+    long long total = 0;
+    for (long long count : counts) total += count;
+    return total / seconds;
+}
+
+/**
+ * @brief Масштабирование АВЛ-дерева по потокам
+ * @param initialKeys Ключей в дереве до замера
+ * @param milliseconds Длительность замера одной конфигурации
+ *
+ * @details
+ * Ключи операций равномерны на [0, 2 * initialKeys), записи поровну
+ * делятся на вставки и удаления, так что размер дерева держится около
+ * initialKeys. Сравниваются insertAVL/removeAVL/searchNode под одной
+ * общей блокировкой и ConcurrentAVL. Выше числа ядер потоки делят ядра,
+ * и рост пропускной способности прекращается.
+ */
+static void compareConcurrentAVL(int initialKeys, int milliseconds) {
+    struct NamedMix {
+        const char* name;
+        int readPercent;
+    };
+    const NamedMix mixes[] = { { "чтение 90/10", 90 }, { "чтение 50/50", 50 } };
+    const int threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+    const int keyRange = initialKeys * 2;
+
+    std::cout << "=== КОНКУРЕНТНОЕ АВЛ-ДЕРЕВО (" << initialKeys << " ключей, ядер: "
+        << std::thread::hardware_concurrency() << ") ===" << std::endl;
+    std::cout << std::setw(17) << "Смесь" << " | " << std::setw(13) << "Потоки" << " | "
+        << "общая блокировка, тыс. оп/с" << " | " << "ConcurrentAVL, тыс. оп/с"
+        << std::endl;
+    std::cout << std::string(79, '-') << std::endl;
+
+    // Размер деревьев держится около initialKeys, поэтому оба дерева
+    // строятся один раз и переходят из замера в замер
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(initialKeys, 0, keyRange - 1, BENCHMARK_SEED);
+    TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
+    std::mutex treeMutex;
+    ConcurrentAVL tree;
+    for (int key : data) tree.insert(key);
+
+    for (const NamedMix& named : mixes) {
+        for (int threads : threadCounts) {
+            double lockedRate = measureThroughput(threads, milliseconds, [&](std::mt19937& random) {
+                int choice = static_cast<int>(random() % 100);
+                int key = static_cast<int>(random() % keyRange);
+                std::lock_guard<std::mutex> lock(treeMutex);
+                if (choice < named.readPercent) TreeProperties::searchNode(avlTree, key);
+                else if (choice & 1) avlTree = TreeBuilders::insertAVL(avlTree, key);
+                else avlTree = TreeBuilders::removeAVL(avlTree, key);
+            });
+            double concurrentRate = measureThroughput(threads, milliseconds, [&](std::mt19937& random) {
+                int choice = static_cast<int>(random() % 100);
+                int key = static_cast<int>(random() % keyRange);
+                if (choice < named.readPercent) tree.contains(key);
+                else if (choice & 1) tree.insert(key);
+                else tree.remove(key);
+            });
+            EpochReclamation::reclaimAll();
+
+            std::cout << std::setw(18) << named.name << " | " << std::setw(7) << threads << " | "
+                << std::fixed << std::setprecision(1) << std::setw(27) << lockedRate / 1000
+                << " | " << std::setw(24) << concurrentRate / 1000 << std::endl;
+        }
+    }
+    TreeBuilders::deleteTree(avlTree);
+    std::cout << std::string(79, '=') << std::endl << std::endl;
+}
+
+/**
+ * @brief Основная функция замеров производительности
+ */
+void runBenchmarks() {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "ЗАМЕРЫ ПРОИЗВОДИТЕЛЬНОСТИ" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::endl;
+
+    std::vector<int> sizes = { 10000, 100000, 1000000, 4000000 };
+    compareLookupThroughput(sizes, 1000000);
+
+    std::vector<int> batchSizes = { 1000, 10000, 100000, 1000000 };
+    compareSortedBatchLookup(1000000, batchSizes);
+
+    compareInputDistributions(20000, 1000000, 1000000);
+
+    compareStreamingBuild(1000000);
+
+    compareWorkloadReplay(100000, 500000);
+
+    compareHardwareCounters(1000000, 1000000);
+
+    compareHugePages(4000000, 1000000);
+
+    compareSnapshotLoad(1000000);
+
+    compareSuccinctTree(1000000, 1000000);
+
+    compareStaticIndex(4000000, 1000000);
+
+    compareConcurrentAVL(1000000, 200);
+}
+
+// ================== Микробенчмарки ==================
+
+/**
+ * @brief Размеры 10^3 .. 10^maxExponent
+ */
+MicrobenchmarkConfig MicrobenchmarkConfig::upTo(int maxExponent) {
+    MicrobenchmarkConfig config;
+    config.sizes.clear();
+    maxExponent = std::max(3, std::min(8, maxExponent));
+    int size = 1000;
+    for (int exponent = 3; exponent <= maxExponent; exponent++) {
+        config.sizes.push_back(size);
+        if (exponent < maxExponent) size *= 10;
+    }
+    return config;
+}
+
+/**
+ * @brief Медиана замеров
+ */
+static double median(std::vector<double> samples) {
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+/**
+ * @brief Результат замеров одного вида дерева одного размера (нс на операцию)
+ */
+struct MicrobenchmarkRow {
+    double buildNs;
+    double lookupNs;
+    double traversalNs;
+    double teardownNs;
+};
+
+/**
+ * @brief Замеры одного вида дерева
+ * @param build Построение: возвращает корень
+ * @param lookup Поиск ключа: true если найден
+ * @param destroy Освобождение дерева
+ *
+ * @details
+ * Каждый прогон строит дерево заново, ищет ключи, обходит дерево и
+ * освобождает его - так замеряются все четыре фазы. Прогревочные прогоны
+ * проходят те же фазы без записи времени.
+ */
+template <typename Node, typename Build, typename Lookup, typename Destroy>
+static MicrobenchmarkRow measureTree(int size, const std::vector<int>& probes, int warmupRuns, int repetitions,
+    Build build, Lookup lookup, Destroy destroy) {
+    std::vector<double> buildNs, lookupNs, traversalNs, teardownNs;
+
+    for (int run = 0; run < warmupRuns + repetitions; run++) {
+        Node* root = nullptr;
+        double buildTime = measureNanoseconds([&]() { root = build(); });
+
+        size_t found = 0;
+        double lookupTime = measureNanoseconds([&]() {
+            for (int key : probes) {
+                if (lookup(root, key)) found++;
+            }
+        });
+        if (found != probes.size()) {
+            std::cerr << "Предупреждение: в дереве найдены не все ключи поиска!" << std::endl;
+        }
+
+        long long checkSum = 0;
+        double traversalTime = measureNanoseconds([&]() {
+            TreeTraversal::visitInOrder(root, [&checkSum](int key) {
+                checkSum += key;
+                return true;
+            });
+        });
+
+        double teardownTime = measureNanoseconds([&]() { destroy(root); });
+
+        if (run >= warmupRuns) {
+            buildNs.push_back(buildTime / size);
+            lookupNs.push_back(lookupTime / probes.size());
+            traversalNs.push_back(traversalTime / size);
+            teardownNs.push_back(teardownTime / size);
+        }
+    }
+
+    return { median(buildNs), median(lookupNs), median(traversalNs), median(teardownNs) };
+}
+
+/**
+ * @brief Строка таблицы: нс на операцию и миллионы операций в секунду
+ */
+static void printMicrobenchmarkRow(const char* tree, int size, const MicrobenchmarkRow& row) {
+    std::cout << std::setw(6) << tree << " | " << std::setw(10) << size;
+    for (double ns : { row.buildNs, row.lookupNs, row.traversalNs, row.teardownNs }) {
+        std::cout << " | " << std::fixed << std::setprecision(1) << std::setw(8) << ns
+            << std::setprecision(2) << std::setw(8) << 1000.0 / ns;
+    }
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Запуск набора микробенчмарков
+ */
+void runMicrobenchmarks(const MicrobenchmarkConfig& config) {
+    std::cout << "==================================================" << std::endl;
+    std::cout << "МИКРОБЕНЧМАРКИ: построение, поиск, обход, удаление" << std::endl;
+    std::cout << "Прогрев: " << config.warmupRuns << ", повторений: " << config.repetitions
+        << " (медиана; для больших n урезается по бюджету)" << std::endl;
+    std::cout << "==================================================" << std::endl;
+    std::cout << std::setw(6) << "Дерево" << " | " << std::setw(10) << "n";
+    for (const char* phase : { "построение", "поиск", "обход", "удаление" }) {
+        std::cout << " | " << std::setw(16) << phase;
+    }
+    std::cout << std::endl << std::setw(6) << "" << " | " << std::setw(10) << "";
+    for (int phase = 0; phase < 4; phase++) {
+        std::cout << " | " << std::setw(8) << "нс/оп" << std::setw(8) << "млн/с";
+    }
+    std::cout << std::endl << std::string(97, '-') << std::endl;
+
+    for (int size : config.sizes) {
+        long long budgetRuns = std::max(1LL, config.keysPerMeasurement / std::max(size, 1));
+        int repetitions = static_cast<int>(std::max(1LL, std::min<long long>(config.repetitions, budgetRuns)));
+        int warmupRuns = static_cast<int>(std::min<long long>(config.warmupRuns, budgetRuns - 1 > 0 ? budgetRuns - 1 : 0));
+
+        std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 0, size * 4 + 1, BENCHMARK_SEED);
+        std::vector<int> sortedData = data;
+        std::sort(sortedData.begin(), sortedData.end());
+
+        std::vector<int> probes = DataGenerator::generateRandomNumbers(config.probeCount, 0, size - 1, BENCHMARK_SEED + 1);
+        for (int& probe : probes) probe = data[probe];
+
+        auto searchBinary = [](TreeNode* root, int key) { return TreeProperties::searchNode(root, key) != nullptr; };
+        auto destroyBinary = [](TreeNode* root) { TreeBuilders::deleteTree(root); };
+
+        printMicrobenchmarkRow("ИСДП", size, measureTree<TreeNode>(size, probes, warmupRuns, repetitions,
+            [&]() { return TreeBuilders::buildPerfectlyBalancedTree(sortedData); }, searchBinary, destroyBinary));
+        printMicrobenchmarkRow("СДП", size, measureTree<TreeNode>(size, probes, warmupRuns, repetitions,
+            [&]() { return TreeBuilders::buildRandomSearchTree(data); }, searchBinary, destroyBinary));
+        printMicrobenchmarkRow("АВЛ", size, measureTree<TreeNode>(size, probes, warmupRuns, repetitions,
+            [&]() { return TreeBuilders::buildAVLTree(data); }, searchBinary, destroyBinary));
+        printMicrobenchmarkRow("ДБД", size, measureTree<DBNode>(size, probes, warmupRuns, repetitions,
+            [&]() { return TreeBuilders::buildDBTree(data, 2); },
+            [](DBNode* root, int key) { return TreeProperties::searchNodeDB(root, key) != nullptr; },
+            [](DBNode* root) { TreeBuilders::deleteDBTree(root); }));
+        std::cout << std::string(97, '-') << std::endl;
+    }
+    std::cout << std::endl;
+}
@@ -0,0 +1,61 @@
+﻿/**
+ * @file benchmarks.h
+ * @brief Заголовочный файл для замеров производительности
+ *
+ * @details
+ * В отличие от лабораторных работ, которые сравнивают форму деревьев,
+ * замеры измеряют время операций на больших деревьях.
+ */
+
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include <vector>
+
+/**
+ * @brief Параметры набора микробенчмарков
+ */
+struct MicrobenchmarkConfig {
+    std::vector<int> sizes = { 1000, 10000, 100000, 1000000 };  ///< Размеры деревьев
+    int warmupRuns = 1;                  ///< Незамеряемых прогонов перед замерами
+    int repetitions = 5;                 ///< Замеряемых прогонов (берется медиана)
+    long long keysPerMeasurement = 10000000;  ///< Бюджет ключей: больше n * прогонов не делается
+    int probeCount = 1000000;            ///< Ключей поиска в одном прогоне
+
+    /**
+     * @brief Размеры 10^3 .. 10^maxExponent
+     * @param maxExponent Степень десяти наибольшего размера (3..8)
+     */
+    static MicrobenchmarkConfig upTo(int maxExponent);
+};
+
+ /**
+  * @brief Запускает замеры производительности
+  *
+  * @details
+  * Сравнивает поиск по одному ключу (searchNode) с пакетным поиском
+  * (searchBatch) на СДП размеров от 10^4 до 4*10^6, а также поиск
+  * отсортированного пакета ключей (searchSortedBatch) для СДП и ДБД.
+  * Затем замеряет построение деревьев и поиск для каждой формы входных
+  * данных (KeyDistribution), построение из потоковых источников (KeySource)
+  * и воспроизведение смешанных трасс операций (Workload). В конце выводит
+  * аппаратные счетчики процессора на ключ (PerfCounters), если они доступны,
+  * и сравнивает поиск в АВЛ-дереве с узлами из кучи и из арены на больших
+  * страницах (HugePageArena).
+  */
+void runBenchmarks();
+
+/**
+ * @brief Запускает набор микробенчмарков
+ * @param config Размеры, прогрев и число повторений
+ *
+ * @details
+ * Для ИСДП, СДП, АВЛ и ДБД каждого размера замеряет построение, поиск
+ * существующих ключей, in-order обход и освобождение памяти. Выводит
+ * нс на операцию (на ключ) и миллионы операций в секунду - медиану
+ * по повторениям. Для больших размеров число прогревов и повторений
+ * урезается по бюджету keysPerMeasurement, но не меньше одного замера.
+ */
+void runMicrobenchmarks(const MicrobenchmarkConfig& config);
+
+#endif // BENCHMARKS_H
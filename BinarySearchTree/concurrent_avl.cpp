@@ -0,0 +1,448 @@
+﻿/**
+ * @file concurrent_avl.cpp
+ * @brief Реализация конкурентного АВЛ-дерева
+ */
+
+#include "concurrent_avl.h"
+#include "epoch_reclamation.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstdlib>
+#include <thread>
+
+/**
+ * @brief Место ключа в дереве, найденное спуском без блокировок
+ */
+struct ConcurrentAVL::Position {
+    ConcurrentNode* parent;       // Последний пройденный узел перед node
+    std::uint64_t parentVersion;  // Версия parent при переходе к node
+    ConcurrentNode* node;         // Узел с ключом или nullptr
+    bool goLeft;                  // node - левый потомок parent
+};
+
+// ================== Блокировки и версии ==================
+
+static void lockNode(ConcurrentNode* node) {
+    while (node->locked.exchange(true, std::memory_order_acquire)) {
+        while (node->locked.load(std::memory_order_relaxed)) std::this_thread::yield();
+    }
+}
+
+static void unlockNode(ConcurrentNode* node) {
+    node->locked.store(false, std::memory_order_release);
+}
+
+/// Пауза перед повторным спуском, как в ожидании блокировки: поток,
+/// проигравший гонку с изменением, не нагружает строку кэша узла
+static void backOff() {
+    std::this_thread::yield();
+}
+
+/// Версия узла вне изменения (ожидание, пока изменение не закончится)
+static std::uint64_t stableVersion(const ConcurrentNode* node) {
+    std::uint64_t version = node->version.load();
+    while (version & 1) {
+        std::this_thread::yield();
+        version = node->version.load();
+    }
+    return version;
+}
+
+// Изменение поддерева узла: версия нечетная от beginChange до endChange
+static void beginChange(ConcurrentNode* node) { node->version.store(node->version.load() + 1); }
+static void endChange(ConcurrentNode* node) { node->version.store(node->version.load() + 1); }
+
+static int heightOf(const ConcurrentNode* node) {
+    return node ? node->height.load() : 0;
+}
+
+static void deleteNode(void* node) {
+    delete static_cast<ConcurrentNode*>(node);
+}
+
+// ================== Изменение структуры ==================
+// Все функции вызываются с заблокированными parent, node и потомками,
+// указатели которых меняются
+
+static void replaceChild(ConcurrentNode* parent, ConcurrentNode* oldChild, ConcurrentNode* newChild) {
+    if (parent->left.load() == oldChild) parent->left.store(newChild);
+    else parent->right.store(newChild);
+}
+
+/**
+ * @brief Исключение узла с не более чем одним потомком
+ */
+static void unlink(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* child) {
+    beginChange(node);
+    node->unlinked.store(true);
+    replaceChild(parent, node, child);
+    if (child) child->parent.store(parent);
+    endChange(node);
+}
+
+/**
+ * @brief Правый поворот вокруг node (left - его левый потомок)
+ *
+ * Поддерево node теряет left и его левое поддерево, поэтому версия node
+ * меняется; поддерево left только растет, его версия прежняя.
+ */
+static void rotateRight(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* left) {
+    beginChange(node);
+    ConcurrentNode* middle = left->right.load();
+    node->left.store(middle);
+    if (middle) middle->parent.store(node);
+    left->right.store(node);
+    node->parent.store(left);
+    replaceChild(parent, node, left);
+    left->parent.store(parent);
+    node->height.store(1 + std::max(heightOf(middle), heightOf(node->right.load())));
+    left->height.store(1 + std::max(heightOf(left->left.load()), node->height.load()));
+    endChange(node);
+}
+
+/**
+ * @brief Левый поворот вокруг node (right - его правый потомок)
+ */
+static void rotateLeft(ConcurrentNode* parent, ConcurrentNode* node, ConcurrentNode* right) {
+    beginChange(node);
+    ConcurrentNode* middle = right->left.load();
+    node->right.store(middle);
+    if (middle) middle->parent.store(node);
+    right->left.store(node);
+    node->parent.store(right);
+    replaceChild(parent, node, right);
+    right->parent.store(parent);
+    node->height.store(1 + std::max(heightOf(node->left.load()), heightOf(middle)));
+    right->height.store(1 + std::max(node->height.load(), heightOf(right->right.load())));
+    endChange(node);
+}
+
+/**
+ * @brief Поворот разбалансированного node (как в insertAVL)
+ * @param balance Разность высот левого и правого поддеревьев node
+ * @return Второй опущенный узел при двойном повороте, иначе nullptr
+ *
+ * Блокирует потомка (и внука при двойном повороте), node и parent
+ * уже заблокированы вызывающим.
+ */
+static ConcurrentNode* rotate(ConcurrentNode* parent, ConcurrentNode* node, int balance) {
+    ConcurrentNode* lowered = nullptr;
+    if (balance > 1) {
+        ConcurrentNode* left = node->left.load();
+        lockNode(left);
+        if (heightOf(left->right.load()) > heightOf(left->left.load())) {
+            ConcurrentNode* middle = left->right.load();
+            lockNode(middle);
+            rotateLeft(node, left, middle);
+            rotateRight(parent, node, middle);
+            unlockNode(middle);
+            lowered = left;
+        }
+        else {
+            rotateRight(parent, node, left);
+        }
+        unlockNode(left);
+    }
+    else {
+        ConcurrentNode* right = node->right.load();
+        lockNode(right);
+        if (heightOf(right->left.load()) > heightOf(right->right.load())) {
+            ConcurrentNode* middle = right->left.load();
+            lockNode(middle);
+            rotateRight(node, right, middle);
+            rotateLeft(parent, node, middle);
+            unlockNode(middle);
+            lowered = right;
+        }
+        else {
+            rotateLeft(parent, node, right);
+        }
+        unlockNode(right);
+    }
+    return lowered;
+}
+
+// ================== ConcurrentAVL ==================
+
+ConcurrentAVL::ConcurrentAVL() : holder(new ConcurrentNode(INT_MIN, nullptr)) {
+    holder->present.store(false);
+}
+
+ConcurrentAVL::~ConcurrentAVL() {
+    std::vector<ConcurrentNode*> stack = { holder };
+    while (!stack.empty()) {
+        ConcurrentNode* node = stack.back();
+        stack.pop_back();
+        if (ConcurrentNode* left = node->left.load()) stack.push_back(left);
+        if (ConcurrentNode* right = node->right.load()) stack.push_back(right);
+        delete node;
+    }
+}
+
+/**
+ * @brief Спуск к ключу без блокировок
+ * @return false если спуск нужно повторить (дерево изменилось по пути)
+ *
+ * @details
+ * Переход parent -> node действителен, если после чтения версии node
+ * parent все еще указывает на node, а версия parent та же, что до чтения
+ * указателя: тогда в момент чтения версии node он был потомком parent
+ * и ключ лежал в его поддереве. Дальше поддерево node может только
+ * расти, пока не изменится его версия, - это проверяется на следующем шаге.
+ */
+bool ConcurrentAVL::locate(int key, Position& position) const {
+    ConcurrentNode* parent = holder;
+    std::uint64_t parentVersion = holder->version.load();
+    bool goLeft = false;
+    ConcurrentNode* node = holder->right.load();
+
+    while (true) {
+        if (node == nullptr) {
+            if (parent->version.load() != parentVersion) return false;
+            position = { parent, parentVersion, nullptr, goLeft };
+            return true;
+        }
+        std::uint64_t version = stableVersion(node);
+        const std::atomic<ConcurrentNode*>& link = goLeft ? parent->left : parent->right;
+        if (link.load() != node || parent->version.load() != parentVersion || node->unlinked.load()) {
+            return false;
+        }
+        if (key == node->key) {
+            position = { parent, parentVersion, node, goLeft };
+            return true;
+        }
+        goLeft = key < node->key;
+        ConcurrentNode* next = goLeft ? node->left.load() : node->right.load();
+        parent = node;
+        parentVersion = version;
+        node = next;
+    }
+}
+
+bool ConcurrentAVL::contains(int key) const {
+    EpochReclamation::Guard guard;
+    Position position;
+    while (!locate(key, position)) backOff();
+    return position.node != nullptr && position.node->present.load();
+}
+
+/**
+ * @brief Вставка
+ *
+ * @details
+ * Если узел с ключом есть (в том числе направляющий), достаточно
+ * заблокировать его и поставить отметку присутствия. Иначе блокируется
+ * узел, под которым найдено пустое место: если его версия та же, что при
+ * спуске, и место все еще пусто, ключ принадлежит именно сюда.
+ */
+bool ConcurrentAVL::insert(int key) {
+    EpochReclamation::Guard guard;
+    while (true) {
+        Position position;
+        if (!locate(key, position)) {
+            backOff();
+            continue;
+        }
+
+        if (ConcurrentNode* node = position.node) {
+            lockNode(node);
+            bool linked = !node->unlinked.load();
+            bool added = linked && !node->present.exchange(true);
+            unlockNode(node);
+            if (linked) return added;
+            continue;
+        }
+
+        ConcurrentNode* parent = position.parent;
+        lockNode(parent);
+        std::atomic<ConcurrentNode*>& slot = position.goLeft ? parent->left : parent->right;
+        if (parent->unlinked.load() || parent->version.load() != position.parentVersion ||
+            slot.load() != nullptr) {
+            unlockNode(parent);
+            continue;
+        }
+        slot.store(new ConcurrentNode(key, parent));
+        unlockNode(parent);
+        rebalance(parent);
+        return true;
+    }
+}
+
+/**
+ * @brief Удаление
+ *
+ * @details
+ * Родитель блокируется раньше узла, и только убедившись, что он все еще
+ * родитель: иначе порядок блокировок (сверху вниз) мог бы нарушиться
+ * после поворота.
+ */
+bool ConcurrentAVL::remove(int key) {
+    EpochReclamation::Guard guard;
+    while (true) {
+        Position position;
+        if (!locate(key, position)) {
+            backOff();
+            continue;
+        }
+        ConcurrentNode* node = position.node;
+        if (node == nullptr) return false;
+
+        ConcurrentNode* parent = position.parent;
+        lockNode(parent);
+        if (parent->unlinked.load() || node->parent.load() != parent) {
+            unlockNode(parent);
+            continue;
+        }
+        lockNode(node);
+        if (node->unlinked.load()) {
+            unlockNode(node);
+            unlockNode(parent);
+            continue;
+        }
+        if (!node->present.load()) {
+            unlockNode(node);
+            unlockNode(parent);
+            return false;
+        }
+
+        ConcurrentNode* left = node->left.load();
+        ConcurrentNode* right = node->right.load();
+        if (left && right) {
+            node->present.store(false);
+            unlockNode(node);
+            unlockNode(parent);
+            return true;
+        }
+        unlink(parent, node, left ? left : right);
+        unlockNode(node);
+        unlockNode(parent);
+        EpochReclamation::retire(node, deleteNode);
+        rebalance(parent);
+        return true;
+    }
+}
+
+/**
+ * @brief Пересчет высот и повороты вверх от node
+ *
+ * @details
+ * На каждом шаге блокируются родитель и node. Высоты потомков node
+ * меняются только под блокировкой node, поэтому прочитанные под ней
+ * значения точны. Подъем заканчивается, когда высота узла не изменилась.
+ * Направляющий узел, у которого остался один потомок, по пути исключается.
+ */
+void ConcurrentAVL::rebalance(ConcurrentNode* node) {
+    while (node != holder) {
+        if (node->unlinked.load()) return;
+        ConcurrentNode* parent = node->parent.load();
+        lockNode(parent);
+        if (parent->unlinked.load() || node->parent.load() != parent) {
+            unlockNode(parent);
+            continue;
+        }
+        lockNode(node);
+        if (node->unlinked.load()) {
+            unlockNode(node);
+            unlockNode(parent);
+            return;
+        }
+
+        ConcurrentNode* left = node->left.load();
+        ConcurrentNode* right = node->right.load();
+        if (!node->present.load() && (left == nullptr || right == nullptr)) {
+            unlink(parent, node, left ? left : right);
+            unlockNode(node);
+            unlockNode(parent);
+            EpochReclamation::retire(node, deleteNode);
+            node = parent;
+            continue;
+        }
+
+        int leftHeight = heightOf(left);
+        int rightHeight = heightOf(right);
+        int balance = leftHeight - rightHeight;
+        if (balance > 1 || balance < -1) {
+            ConcurrentNode* lowered = rotate(parent, node, balance);
+            unlockNode(node);
+            unlockNode(parent);
+            // Опущенные узлы проверяются снова, высота parent - следующим шагом:
+            // после удаления поворот уменьшает высоту поддерева
+            if (lowered) rebalance(lowered);
+            rebalance(node);
+            node = parent;
+            continue;
+        }
+
+        int height = 1 + std::max(leftHeight, rightHeight);
+        bool changed = node->height.load() != height;
+        node->height.store(height);
+        unlockNode(node);
+        unlockNode(parent);
+        if (!changed) return;
+        node = parent;
+    }
+}
+
+// ================== Проверки (без одновременных изменений) ==================
+
+static long long countPresent(const ConcurrentNode* node) {
+    if (node == nullptr) return 0;
+    return (node->present.load() ? 1 : 0) + countPresent(node->left.load()) + countPresent(node->right.load());
+}
+
+static int actualHeight(const ConcurrentNode* node) {
+    if (node == nullptr) return 0;
+    return 1 + std::max(actualHeight(node->left.load()), actualHeight(node->right.load()));
+}
+
+static void collectKeys(const ConcurrentNode* node, std::vector<int>& keys) {
+    if (node == nullptr) return;
+    collectKeys(node->left.load(), keys);
+    if (node->present.load()) keys.push_back(node->key);
+    collectKeys(node->right.load(), keys);
+}
+
+/**
+ * @brief Проверка поддерева
+ * @param min, max Допустимый диапазон ключей (не включая границы)
+ * @param height Вычисленная высота поддерева
+ */
+static bool checkSubtree(const ConcurrentNode* node, const ConcurrentNode* parent,
+    long long min, long long max, int& height) {
+    if (node == nullptr) {
+        height = 0;
+        return true;
+    }
+    if (node->parent.load() != parent || node->unlinked.load() || node->locked.load() ||
+        node->key <= min || node->key >= max) {
+        return false;
+    }
+    int leftHeight = 0;
+    int rightHeight = 0;
+    if (!checkSubtree(node->left.load(), node, min, node->key, leftHeight) ||
+        !checkSubtree(node->right.load(), node, node->key, max, rightHeight)) {
+        return false;
+    }
+    height = 1 + std::max(leftHeight, rightHeight);
+    return node->height.load() == height && std::abs(leftHeight - rightHeight) <= 1;
+}
+
+long long ConcurrentAVL::size() const {
+    return countPresent(holder->right.load());
+}
+
+int ConcurrentAVL::height() const {
+    return actualHeight(holder->right.load());
+}
+
+std::vector<int> ConcurrentAVL::keys() const {
+    std::vector<int> result;
+    collectKeys(holder->right.load(), result);
+    return result;
+}
+
+bool ConcurrentAVL::isValid() const {
+    int height = 0;
+    return checkSubtree(holder->right.load(), holder, LLONG_MIN, LLONG_MAX, height);
+}
@@ -0,0 +1,114 @@
+﻿#ifndef CONCURRENT_AVL_H
+#define CONCURRENT_AVL_H
+
+#include "node_memory.h"
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file concurrent_avl.h
+ * @brief АВЛ-дерево для одновременной работы нескольких потоков
+ *
+ * TreeBuilders::insertAVL рассчитан на один поток. ConcurrentAVL
+ * допускает одновременные поиски, вставки и удаления из любого числа
+ * потоков:
+ * - поиск не берет блокировок: у каждого узла есть номер версии, который
+ *   меняется, когда поддерево узла теряет ключи (поворот опускает узел,
+ *   узел исключается из дерева). Спускаясь, поиск читает версию узла,
+ *   затем указатель на потомка и версию потомка, и проверяет, что версия
+ *   узла не изменилась; иначе поиск начинается заново от корня;
+ * - вставка блокирует только узел, к которому подвешивается новый лист,
+ *   балансировка - узел, его родителя и участвующих в повороте потомков
+ *   (сверху вниз, поэтому взаимных блокировок нет);
+ * - удаление узла с двумя потомками только снимает отметку присутствия
+ *   (узел остается направляющим), узел с одним потомком исключается
+ *   из дерева и освобождается через EpochReclamation, когда его уже не
+ *   может читать ни один поиск.
+ *
+ * Высоты узлов - подсказки для балансировки: каждая вставка и удаление
+ * пересчитывают их вверх от места изменения, как insertAVL, но
+ * одновременные изменения соседних поддеревьев могут ненадолго
+ * нарушить условие АВЛ, пока балансировка не дойдет до общего предка.
+ */
+
+/**
+ * @brief Узел конкурентного АВЛ-дерева
+ */
+struct ConcurrentNode {
+    const int key;
+    std::atomic<bool> present;                  // false - ключ удален, узел только направляет поиск
+    std::atomic<bool> unlinked;                 // Узел исключен из дерева
+    std::atomic<int> height;
+    std::atomic<std::uint64_t> version;         // Нечетная - поддерево узла сейчас меняется
+    std::atomic<ConcurrentNode*> left;
+    std::atomic<ConcurrentNode*> right;
+    std::atomic<ConcurrentNode*> parent;
+    std::atomic<bool> locked;                   // Блокировка изменений узла
+
+    ConcurrentNode(int k, ConcurrentNode* p)
+        : key(k), present(true), unlinked(false), height(1), version(0),
+        left(nullptr), right(nullptr), parent(p), locked(false) {
+    }
+
+    static void* operator new(std::size_t bytes) { return NodeMemory::allocate(bytes); }
+    static void operator delete(void* pointer, std::size_t bytes) { NodeMemory::deallocate(pointer, bytes); }
+};
+
+class ConcurrentAVL {
+public:
+    ConcurrentAVL();
+    ~ConcurrentAVL();
+
+    ConcurrentAVL(const ConcurrentAVL&) = delete;
+    ConcurrentAVL& operator=(const ConcurrentAVL&) = delete;
+
+    /**
+     * @brief Поиск ключа без блокировок
+     * @param key Искомый ключ
+     * @return true если ключ есть в дереве
+     */
+    bool contains(int key) const;
+
+    /**
+     * @brief Вставка ключа
+     * @param key Ключ
+     * @return false если ключ уже был в дереве
+     */
+    bool insert(int key);
+
+    /**
+     * @brief Удаление ключа
+     * @param key Ключ
+     * @return false если ключа не было
+     */
+    bool remove(int key);
+
+    // Следующие функции - только когда дерево не меняется другими потоками
+
+    /// Количество ключей (направляющие узлы не считаются)
+    long long size() const;
+
+    /// Высота дерева (для пустого 0)
+    int height() const;
+
+    /// Ключи по возрастанию
+    std::vector<int> keys() const;
+
+    /**
+     * @brief Проверка структуры
+     * @return true если соблюдены порядок ключей, ссылки на родителей,
+     *         сохраненные высоты и условие АВЛ
+     */
+    bool isValid() const;
+
+private:
+    struct Position;
+
+    bool locate(int key, Position& position) const;
+    void rebalance(ConcurrentNode* node);
+
+    ConcurrentNode* holder;  // Служебный узел: корень дерева - его правый потомок
+};
+
+#endif // CONCURRENT_AVL_H
@@ -1,52 +1,391 @@
 #include "data_generator.h"
 #include <algorithm>
+#include <cmath>
 #include <random>
-#include <unordered_set>
+#include <thread>
 
 /**
  * @file data_generator.cpp
  * @brief       
  */
 
+//      :   
+static const int PARALLEL_THRESHOLD = 1 << 16;
+
+/**
+ * @brief  SplitMix64
+ *
+ * splitMix64(seed + (i + 1) * GOLDEN) - i-   SplitMix64,  
+ *   :      .
+ */
+static unsigned long long splitMix64(unsigned long long z) {
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static const unsigned long long GOLDEN = 0x9E3779B97F4A7C15ULL;
+
+/**
+ * @brief     
+ * @param out   (  )
+ * @param threadCount   (0 -   )
+ * @param fill  fill(begin, end),  out[begin, end)
+ *
+ * @note fill     ,  
+ *           .
+ */
+template <typename Fill>
+static void fillInParallel(std::vector<int>& out, int threadCount, Fill fill) {
+    size_t n = out.size();
+    if (threadCount <= 0) {
+        threadCount = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    }
+    if (threadCount == 1 || n < static_cast<size_t>(PARALLEL_THRESHOLD)) {
+        fill(size_t(0), n);
+        return;
+    }
+
+    size_t chunk = (n + threadCount - 1) / threadCount;
+    std::vector<std::thread> workers;
+    for (size_t begin = chunk; begin < n; begin += chunk) {
+        size_t end = std::min(n, begin + chunk);
+        workers.emplace_back([&fill, begin, end]() { fill(begin, end); });
+    }
+    fill(size_t(0), std::min(n, chunk));
+    for (std::thread& worker : workers) worker.join();
+}
+
  /**
-  * @brief     
+  * @brief    [0, size)
   *
-  *      C++ std::mt19937
-  *   .    
-  * - (unordered_set).
+  *       ,   size
+  * (   halfBits ).     ;  
+  *  size    (cycle walking),  
+  *   [0, size)  .   4 * size,   
+  *    4 .
   */
-std::vector<int> DataGenerator::generateUniqueNumbers(int count, int minVal, int maxVal) {
+class FeistelPermutation {
+public:
+    FeistelPermutation(unsigned long long size, unsigned long long seed)
+        : size(size), halfBits(1) {
+        while ((1ULL << (2 * halfBits)) < size) {
+            ++halfBits;
+        }
+        halfMask = (1ULL << halfBits) - 1;
+        for (int r = 0; r < ROUNDS; ++r) {
+            seed += GOLDEN;
+            roundKeys[r] = splitMix64(seed);
+        }
+    }
+
+    unsigned long long operator()(unsigned long long index) const {
+        unsigned long long x = index;
+        do {
+            x = encrypt(x);
+        } while (x >= size);
+        return x;
+    }
+
+private:
+    static const int ROUNDS = 4;
+
+    unsigned long long size;
+    int halfBits;
+    unsigned long long halfMask;
+    unsigned long long roundKeys[ROUNDS];
+
+    unsigned long long encrypt(unsigned long long x) const {
+        unsigned long long left = x >> halfBits;
+        unsigned long long right = x & halfMask;
+        for (int r = 0; r < ROUNDS; ++r) {
+            //  :     -   splitMix64
+            unsigned long long z = (right ^ roundKeys[r]) * GOLDEN;
+            unsigned long long next = left ^ ((z ^ (z >> 29)) & halfMask);
+            left = right;
+            right = next;
+        }
+        return (left << halfBits) | right;
+    }
+};
+
+/**
+ * @brief     
+ *
+ * i-  - minVal + P(i),  P -   .
+ *     P, -  ,
+ *  -   .     ,
+ *     .
+ */
+std::vector<int> DataGenerator::generateUniqueNumbers(int count, int minVal, int maxVal,
+                                                      unsigned long long seed, int threadCount) {
     //   
-    if (count <= 0) {
+    if (count <= 0 || maxVal < minVal) {
         return std::vector<int>();
     }
 
     //  ,       
-    int availableNumbers = maxVal - minVal + 1;
+    long long availableNumbers = static_cast<long long>(maxVal) - minVal + 1;
     if (count > availableNumbers) {
-        count = availableNumbers;
+        count = static_cast<int>(availableNumbers);
+    }
+
+    std::vector<int> result;
+    generateUniqueChunk(result, 0, count, minVal, maxVal, resolveSeed(seed), threadCount);
+    return result;
+}
+
+/**
+ * @brief   generateUniqueNumbers
+ *
+ *    [first, first + count)   :
+ *     generateUniqueNumbers    seed.
+ */
+void DataGenerator::generateUniqueChunk(std::vector<int>& chunk, long long first, int count,
+                                        int minVal, int maxVal, unsigned long long seed,
+                                        int threadCount) {
+    chunk.resize(count > 0 ? count : 0);
+    if (chunk.empty() || maxVal < minVal) {
+        chunk.clear();
+        return;
+    }
+
+    long long availableNumbers = static_cast<long long>(maxVal) - minVal + 1;
+    FeistelPermutation permutation(static_cast<unsigned long long>(availableNumbers), seed);
+
+    fillInParallel(chunk, threadCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            chunk[i] = static_cast<int>(minVal + static_cast<long long>(permutation(first + i)));
+        }
+    });
+}
+
+/**
+ * @brief    std::random_device,  seed == 0
+ */
+unsigned long long DataGenerator::resolveSeed(unsigned long long seed) {
+    if (seed == 0) {
+        std::random_device rd;
+        seed = (static_cast<unsigned long long>(rd()) << 32) | rd();
+    }
+    return seed;
+}
+
+/**
+ * @brief     
+ *
+ * i-  - i-   SplitMix64,   
+ *   32     ( ).
+ */
+std::vector<int> DataGenerator::generateRandomNumbers(int count, int minVal, int maxVal,
+                                                      unsigned long long seed, int threadCount) {
+    if (count <= 0 || maxVal < minVal) {
+        return std::vector<int>();
+    }
+
+    unsigned long long range = static_cast<unsigned long long>(static_cast<long long>(maxVal) - minVal + 1);
+    seed = resolveSeed(seed);
+
+    std::vector<int> result(count);
+    fillInParallel(result, threadCount, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            unsigned long long bits = splitMix64(seed + (i + 1) * GOLDEN) >> 32;
+            result[i] = static_cast<int>(minVal + static_cast<long long>((bits * range) >> 32));
+        }
+    });
+
+    return result;
+}
+
+/**
+ * @brief   1..n   
+ *
+ *  rejection-inversion (Hormann, Derflinger): O(1)  
+ *   ,  n     .
+ */
+class ZipfSampler {
+public:
+    ZipfSampler(unsigned long long n, double exponent)
+        : n(static_cast<double>(n)), exponent(exponent) {
+        hIntegralX1 = hIntegral(1.5) - 1.0;
+        hIntegralN = hIntegral(this->n + 0.5);
+        s = 2.0 - hIntegralInverse(hIntegral(2.5) - h(2.0));
+    }
+
+    /**
+     * @brief  
+     * @param state   SplitMix64,   
+     *           
+     */
+    unsigned long long operator()(unsigned long long state) const {
+        while (true) {
+            state += GOLDEN;
+            double unit = (splitMix64(state) >> 11) * (1.0 / 9007199254740992.0);
+            double u = hIntegralN + unit * (hIntegralX1 - hIntegralN);
+            double x = hIntegralInverse(u);
+            double k = std::floor(x + 0.5);
+            if (k < 1.0) k = 1.0;
+            if (k > n) k = n;
+            if (k - x <= s || u >= hIntegral(k + 0.5) - h(k)) {
+                return static_cast<unsigned long long>(k);
+            }
+        }
+    }
+
+private:
+    double n;
+    double exponent;
+    double hIntegralX1;
+    double hIntegralN;
+    double s;
+
+    double h(double x) const {
+        return std::exp(-exponent * std::log(x));
+    }
+
+    double hIntegral(double x) const {
+        double logX = std::log(x);
+        return expm1Ratio((1.0 - exponent) * logX) * logX;
+    }
+
+    double hIntegralInverse(double x) const {
+        double t = x * (1.0 - exponent);
+        if (t < -1.0) t = -1.0;
+        return std::exp(log1pRatio(t) * x);
+    }
+
+    // log1p(x) / x     
+    static double log1pRatio(double x) {
+        if (std::fabs(x) > 1e-8) return std::log1p(x) / x;
+        return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+
+    // expm1(x) / x     
+    static double expm1Ratio(double x) {
+        if (std::fabs(x) > 1e-8) return std::expm1(x) / x;
+        return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
     }
+};
 
-    //   
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<int> dist(minVal, maxVal);
+/**
+ * @brief    
+ *
+ * - Sorted/Reverse/NearlySorted     ;
+ *   NearlySorted    NEARLY_SORTED_WINDOW ,
+ *              .
+ * - Clustered:    CLUSTER_COUNT ,   
+ *        .
+ * - Zipf:       ZIPF_EXPONENT,
+ *    k   minVal + P(k - 1).
+ */
+std::vector<int> DataGenerator::generateKeys(KeyDistribution distribution, int count,
+                                             int minVal, int maxVal, unsigned long long seed) {
+    const int NEARLY_SORTED_WINDOW = 8;
+    const int CLUSTER_COUNT = 8;
+    const double ZIPF_EXPONENT = 1.0;
+
+    if (count <= 0 || maxVal < minVal) {
+        return std::vector<int>();
+    }
+    seed = resolveSeed(seed);
+    long long range = static_cast<long long>(maxVal) - minVal + 1;
+    std::mt19937_64 gen(seed);
 
-    //  unordered_set   
-    std::unordered_set<int> uniqueNumbers;
+    std::vector<int> keys;
+    switch (distribution) {
+    case KeyDistribution::Uniform:
+        return generateUniqueNumbers(count, minVal, maxVal, seed);
 
-    //        
-    while (uniqueNumbers.size() < static_cast<size_t>(count)) {
-        int num = dist(gen);
-        uniqueNumbers.insert(num);
+    case KeyDistribution::Sorted:
+        keys = generateUniqueNumbers(count, minVal, maxVal, seed);
+        std::sort(keys.begin(), keys.end());
+        return keys;
+
+    case KeyDistribution::Reverse:
+        keys = generateUniqueNumbers(count, minVal, maxVal, seed);
+        std::sort(keys.begin(), keys.end(), [](int a, int b) { return a > b; });
+        return keys;
+
+    case KeyDistribution::NearlySorted:
+        keys = generateUniqueNumbers(count, minVal, maxVal, seed);
+        std::sort(keys.begin(), keys.end());
+        for (size_t i = 0; i < keys.size(); i += NEARLY_SORTED_WINDOW) {
+            size_t end = std::min(keys.size(), i + NEARLY_SORTED_WINDOW);
+            std::shuffle(keys.begin() + i, keys.begin() + end, gen);
+        }
+        return keys;
+
+    case KeyDistribution::Zipf: {
+        FeistelPermutation permutation(static_cast<unsigned long long>(range), seed);
+        ZipfSampler sampler(static_cast<unsigned long long>(range), ZIPF_EXPONENT);
+        //   i-     :      
+        keys.resize(count);
+        fillInParallel(keys, 0, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                unsigned long long rank = sampler(splitMix64(seed ^ ((i + 1) * GOLDEN)));
+                keys[i] = static_cast<int>(minVal + static_cast<long long>(permutation(rank - 1)));
+            }
+        });
+        return keys;
+    }
+
+    case KeyDistribution::Clustered: {
+        if (count > range) count = static_cast<int>(range);
+        long long slot = range / CLUSTER_COUNT;
+        int perCluster = (count + CLUSTER_COUNT - 1) / CLUSTER_COUNT;
+        if (slot < perCluster) {
+            //      
+            return generateUniqueNumbers(count, minVal, maxVal, seed);
+        }
+        keys.reserve(count);
+        for (int c = 0; c < CLUSTER_COUNT && static_cast<int>(keys.size()) < count; ++c) {
+            int length = std::min(perCluster, count - static_cast<int>(keys.size()));
+            std::uniform_int_distribution<long long> offset(0, slot - length);
+            long long start = minVal + c * slot + offset(gen);
+            for (int i = 0; i < length; ++i) {
+                keys.push_back(static_cast<int>(start + i));
+            }
+        }
+        std::shuffle(keys.begin(), keys.end(), gen);
+        return keys;
+    }
     }
 
-    //  set  vector  
-    std::vector<int> result(uniqueNumbers.begin(), uniqueNumbers.end());
+    return keys;
+}
+
+/**
+ * @brief      (,  Zipf)
+ */
+std::vector<KeyDistribution> DataGenerator::buildDistributions() {
+    return { KeyDistribution::Uniform, KeyDistribution::Sorted, KeyDistribution::Reverse,
+             KeyDistribution::NearlySorted, KeyDistribution::Clustered };
+}
 
+/**
+ * @brief   
+ */
+std::vector<KeyDistribution> DataGenerator::allDistributions() {
+    std::vector<KeyDistribution> result = buildDistributions();
+    result.push_back(KeyDistribution::Zipf);
     return result;
 }
 
+/**
+ * @brief     
+ */
+const char* DataGenerator::distributionName(KeyDistribution distribution) {
+    switch (distribution) {
+    case KeyDistribution::Uniform:      return "";
+    case KeyDistribution::Sorted:       return "";
+    case KeyDistribution::Reverse:      return "";
+    case KeyDistribution::NearlySorted: return " ";
+    case KeyDistribution::Zipf:         return "";
+    case KeyDistribution::Clustered:    return "";
+    }
+    return "?";
+}
+
 /**
  * @brief     
  *
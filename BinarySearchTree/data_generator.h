@@ -12,6 +12,19 @@
  *    .
  */
 
+/**
+ * @brief    
+ */
+enum class KeyDistribution {
+    Uniform,        ///<  ,   
+    Sorted,         ///<   (  )
+    Reverse,        ///<  
+    NearlySorted,   ///<       
+    Zipf,           ///<   :  k-    ~ 1/k
+    Clustered       ///<      ,  
+                    ///< (     -  )
+};
+
 class DataGenerator {
 public:
     /**
@@ -19,12 +32,93 @@ public:
      * @param count    
      * @param minVal    (  1)
      * @param maxVal    (  1000)
+     * @param seed   (0 -    std::random_device)
+     * @param threadCount   (0 -   )
      * @return    
      *
      * @note    ,     [minVal, maxVal],
      *             .
+     * @note  -   0..count-1    
+     *       ( ),     -,  O(count),
+     *           seed  
+     *           threadCount.
+     */
+    static std::vector<int> generateUniqueNumbers(int count, int minVal = 1, int maxVal = 1000,
+                                                  unsigned long long seed = 0, int threadCount = 0);
+
+    /**
+     * @brief   generateUniqueNumbers
+     * @param chunk   ( count )
+     * @param first     
+     * @param count    
+     * @param minVal  
+     * @param maxVal  
+     * @param seed   (, . resolveSeed)
+     * @param threadCount   (0 -   )
+     *
+     * @note    first + count <= maxVal - minVal + 1.
+     *        GeneratedKeySource   .
+     */
+    static void generateUniqueChunk(std::vector<int>& chunk, long long first, int count,
+                                    int minVal, int maxVal, unsigned long long seed,
+                                    int threadCount = 0);
+
+    /**
+     * @brief  : seed,    std::random_device  seed == 0
+     */
+    static unsigned long long resolveSeed(unsigned long long seed);
+
+    /**
+     * @brief     
+     * @param count  
+     * @param minVal  
+     * @param maxVal  
+     * @param seed   (0 -  )
+     * @param threadCount   (0 -   )
+     * @return    
+     *
+     * @note    (SplitMix64): i-  
+     *        seed  i,    seed   
+     *        threadCount.
+     */
+    static std::vector<int> generateRandomNumbers(int count, int minVal = 1, int maxVal = 1000,
+                                                  unsigned long long seed = 0, int threadCount = 0);
+
+    /**
+     * @brief    
+     * @param distribution  
+     * @param count  
+     * @param minVal  
+     * @param maxVal  
+     * @param seed   (0 -  )
+     * @return  
+     *
+     * @note   ,  Zipf,      
+     *       . Zipf -    ;   
+     *           ,    generateUniqueNumbers.
+     * @note      (   Clustered)  count 
+     *         [minVal, maxVal]    - 
+     *       ,   generateUniqueNumbers.   
+     *         ,    count.
+     */
+    static std::vector<int> generateKeys(KeyDistribution distribution, int count,
+                                         int minVal = 1, int maxVal = 1000,
+                                         unsigned long long seed = 0);
+
+    /**
+     * @brief      (,  Zipf)
+     */
+    static std::vector<KeyDistribution> buildDistributions();
+
+    /**
+     * @brief   
+     */
+    static std::vector<KeyDistribution> allDistributions();
+
+    /**
+     * @brief     
      */
-    static std::vector<int> generateUniqueNumbers(int count, int minVal = 1, int maxVal = 1000);
+    static const char* distributionName(KeyDistribution distribution);
 
     /**
      * @brief     
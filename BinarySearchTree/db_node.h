@@ -1,6 +1,7 @@
 #ifndef DB_NODE_H
 #define DB_NODE_H
 
+#include "node_memory.h"
 #include <vector>
 
 /**
@@ -10,12 +11,14 @@
  *      (   )
  *      ().
  *    t (t >= 2),     .
+ *        NodeMemory,   
+ *    .
  */
 struct DBNode {
-    std::vector<int> keys;       //   ,   
-    std::vector<DBNode*> children; //   : size = keys.size() + 1
+    std::vector<int, NodeAllocator<int>> keys;           //   ,   
+    std::vector<DBNode*, NodeAllocator<DBNode*>> children; //   : size = keys.size() + 1
     bool isLeaf;                 //  
-    int level;                   //     (  )
+    int level;                   //   ( - 0),    
 
     /**
      * @brief   
@@ -23,6 +26,9 @@ struct DBNode {
      * @param lvl    
      */
     DBNode(bool leaf, int lvl) : isLeaf(leaf), level(lvl) {}
+
+    static void* operator new(std::size_t bytes) { return NodeMemory::allocate(bytes); }
+    static void operator delete(void* pointer, std::size_t bytes) { NodeMemory::deallocate(pointer, bytes); }
 };
 
 #endif // DB_NODE_H
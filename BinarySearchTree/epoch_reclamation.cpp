@@ -0,0 +1,182 @@
+﻿/**
+ * @file epoch_reclamation.cpp
+ * @brief Реализация отложенного освобождения памяти по эпохам
+ */
+
+#include "epoch_reclamation.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Попыток продвинуть эпоху - раз на столько отложенных объектов
+static const int ADVANCE_INTERVAL = 64;
+
+// Списков отложенных объектов у потока: эпохи e, e - 1 и e - 2
+static const int LIMBO_LISTS = 3;
+
+/**
+ * @brief Отложенный объект
+ */
+struct Retired {
+    void* pointer;
+    void (*deleter)(void*);
+};
+
+/**
+ * @brief Место потока в таблице активных эпох
+ */
+struct ThreadSlot {
+    std::atomic<unsigned long long> active{ 0 };  // Эпоха входа в секцию, 0 - вне секции
+    std::atomic<bool> claimed{ false };
+};
+
+// Эпохи начинаются с 1: значение 0 в ThreadSlot::active - "вне секции"
+static std::atomic<unsigned long long> globalEpoch{ 1 };
+static ThreadSlot slots[EpochReclamation::MAX_THREADS];
+static std::atomic<long long> pendingCount{ 0 };
+
+// Объекты завершившихся потоков с эпохами, в которые они отложены
+static std::mutex orphanMutex;
+static std::vector<std::pair<unsigned long long, Retired>> orphans;
+
+static void release(std::vector<Retired>& list) {
+    for (const Retired& retired : list) retired.deleter(retired.pointer);
+    pendingCount -= static_cast<long long>(list.size());
+    list.clear();
+}
+
+/**
+ * @brief Состояние потока: место в таблице, вложенность секций, списки
+ */
+struct ThreadState {
+    ThreadSlot* slot = nullptr;
+    int depth = 0;
+    int sinceAdvance = 0;
+    std::vector<Retired> limbo[LIMBO_LISTS];
+    unsigned long long limboEpoch[LIMBO_LISTS] = { 0, 0, 0 };
+
+    /// При завершении потока списки передаются в общий, место освобождается
+    ~ThreadState() {
+        {
+            std::lock_guard<std::mutex> lock(orphanMutex);
+            for (int list = 0; list < LIMBO_LISTS; list++) {
+                for (const Retired& retired : limbo[list]) orphans.push_back({ limboEpoch[list], retired });
+            }
+        }
+        if (slot) {
+            slot->active.store(0);
+            slot->claimed.store(false);
+        }
+    }
+};
+
+static thread_local ThreadState threadState;
+
+/**
+ * @brief Захват свободного места в таблице (ожидание, если все заняты)
+ */
+static ThreadSlot* acquireSlot() {
+    while (true) {
+        for (ThreadSlot& slot : slots) {
+            bool expected = false;
+            if (!slot.claimed.load() && slot.claimed.compare_exchange_strong(expected, true)) return &slot;
+        }
+        std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Продвижение эпохи, если все потоки в секциях видели текущую
+ */
+static void tryAdvance() {
+    unsigned long long epoch = globalEpoch.load();
+    for (const ThreadSlot& slot : slots) {
+        unsigned long long active = slot.active.load();
+        if (active != 0 && active != epoch) return;
+    }
+    globalEpoch.compare_exchange_strong(epoch, epoch + 1);
+}
+
+/**
+ * @brief Освобождение списков потока и общего списка, отложенных
+ *        не позже чем за две эпохи до текущей
+ */
+static void collect(ThreadState& state) {
+    unsigned long long epoch = globalEpoch.load();
+    for (int list = 0; list < LIMBO_LISTS; list++) {
+        if (!state.limbo[list].empty() && state.limboEpoch[list] + 2 <= epoch) release(state.limbo[list]);
+    }
+
+    std::unique_lock<std::mutex> lock(orphanMutex, std::try_to_lock);
+    if (!lock.owns_lock() || orphans.empty()) return;
+    std::vector<Retired> ready;
+    size_t kept = 0;
+    for (const auto& orphan : orphans) {
+        if (orphan.first + 2 <= epoch) ready.push_back(orphan.second);
+        else orphans[kept++] = orphan;
+    }
+    orphans.resize(kept);
+    lock.unlock();
+    release(ready);
+}
+
+void EpochReclamation::enter() {
+    ThreadState& state = threadState;
+    if (state.depth++ > 0) return;
+    if (!state.slot) state.slot = acquireSlot();
+    state.slot->active.store(globalEpoch.load());
+}
+
+void EpochReclamation::exit() {
+    ThreadState& state = threadState;
+    if (--state.depth == 0) state.slot->active.store(0);
+}
+
+/**
+ * @brief Отложенное освобождение
+ *
+ * @details
+ * Список выбирается по эпохе e mod 3. Если в нем лежат объекты более
+ * ранней эпохи, то это эпоха не позже e - 3, и они уже свободны от
+ * читателей - список освобождается и начинается заново.
+ */
+void EpochReclamation::retire(void* pointer, void (*deleter)(void*)) {
+    ThreadState& state = threadState;
+    unsigned long long epoch = globalEpoch.load();
+    int list = static_cast<int>(epoch % LIMBO_LISTS);
+    if (state.limboEpoch[list] != epoch) {
+        release(state.limbo[list]);
+        state.limboEpoch[list] = epoch;
+    }
+    state.limbo[list].push_back({ pointer, deleter });
+    pendingCount++;
+
+    if (++state.sinceAdvance >= ADVANCE_INTERVAL) {
+        state.sinceAdvance = 0;
+        tryAdvance();
+        collect(state);
+    }
+}
+
+void EpochReclamation::reclaimAll() {
+    ThreadState& state = threadState;
+    for (int list = 0; list < LIMBO_LISTS; list++) release(state.limbo[list]);
+
+    std::vector<Retired> ready;
+    {
+        std::lock_guard<std::mutex> lock(orphanMutex);
+        for (const auto& orphan : orphans) ready.push_back(orphan.second);
+        orphans.clear();
+    }
+    release(ready);
+}
+
+long long EpochReclamation::pending() {
+    return pendingCount.load();
+}
+
+unsigned long long EpochReclamation::epoch() {
+    return globalEpoch.load();
+}
@@ -0,0 +1,72 @@
+﻿#ifndef EPOCH_RECLAMATION_H
+#define EPOCH_RECLAMATION_H
+
+#include <cstddef>
+
+/**
+ * @file epoch_reclamation.h
+ * @brief Отложенное освобождение памяти по эпохам
+ *
+ * Читатели конкурентных структур обходят узлы без блокировок, поэтому
+ * узел, исключенный из структуры, нельзя освободить сразу: его может еще
+ * читать другой поток. Каждый поток перед обращением к структуре входит
+ * в критическую секцию (EpochReclamation::Guard) и запоминает глобальную
+ * эпоху. Исключенный узел передается в retire() и попадает в список
+ * потока с пометкой текущей эпохи. Эпоха продвигается, когда все потоки
+ * в критических секциях уже видели текущую; узлы, отложенные в эпоху e,
+ * освобождаются, когда глобальная эпоха достигнет e + 2, - к этому
+ * моменту все потоки, которые могли их видеть, из секций вышли.
+ *
+ * Списки у каждого потока свои; при завершении потока его неосвобожденные
+ * узлы переходят в общий список и освобождаются следующими потоками.
+ */
+class EpochReclamation {
+public:
+    /// Наибольшее число одновременно зарегистрированных потоков
+    static const int MAX_THREADS = 256;
+
+    /**
+     * @brief Критическая секция потока (RAII)
+     *
+     * Пока объект существует, узлы, прочитанные потоком, не освобождаются.
+     * Секции могут быть вложенными.
+     */
+    class Guard {
+    public:
+        Guard() { enter(); }
+        ~Guard() { exit(); }
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+    };
+
+    /**
+     * @brief Отложенное освобождение
+     * @param pointer Исключенный из структуры объект
+     * @param deleter Функция освобождения
+     *
+     * @note Вызывается внутри Guard, после того как объект стал
+     *       недостижим для новых читателей.
+     */
+    static void retire(void* pointer, void (*deleter)(void*));
+
+    /**
+     * @brief Освобождение объектов, отложенных текущим потоком
+     *        и уже завершившимися потоками
+     *
+     * @warning Только когда ни один поток не находится в Guard
+     *          (например, после join всех рабочих потоков).
+     */
+    static void reclaimAll();
+
+    /// Объектов, отложенных и еще не освобожденных (во всех потоках)
+    static long long pending();
+
+    /// Текущая глобальная эпоха
+    static unsigned long long epoch();
+
+private:
+    static void enter();
+    static void exit();
+};
+
+#endif // EPOCH_RECLAMATION_H
@@ -0,0 +1,177 @@
+﻿/**
+ * @file huge_page_arena.cpp
+ * @brief Реализация арены узлов на больших страницах
+ */
+
+#include "huge_page_arena.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#elif defined(_WIN32)
+#include <windows.h>
+#endif
+
+// Количество классов размеров (блоки кратны 16 байтам)
+static const size_t CLASS_COUNT = HugePageArena::MAX_BLOCK / 16;
+
+// Зарезервированный диапазон [rangeBegin, rangeEnd), задается один раз
+static std::atomic<char*> rangeBegin{ nullptr };
+static std::atomic<char*> rangeEnd{ nullptr };
+static std::atomic<size_t> nextRegion{ 0 };
+static std::atomic<bool> enabled{ false };
+static std::atomic<bool> advised{ false };
+static std::mutex reserveMutex;
+
+/**
+ * @brief Регион и списки свободных блоков текущего потока
+ */
+struct ThreadArena {
+    char* cursor = nullptr;
+    char* end = nullptr;
+    void* freeLists[CLASS_COUNT] = {};
+};
+
+static thread_local ThreadArena threadArena;
+
+/**
+ * @brief Резервирование диапазона, выровненного на REGION_SIZE
+ * @param bytes Размер диапазона (кратен REGION_SIZE)
+ * @return Начало диапазона или nullptr
+ *
+ * @details
+ * Резервируется на регион больше, затем невыровненные края отдаются
+ * обратно (Linux) или просто не используются (Windows). На Linux страницы
+ * подтверждаются при первом касании, MAP_NORESERVE не учитывает весь
+ * диапазон в лимите overcommit.
+ */
+static char* reserveRange(size_t bytes) {
+    size_t total = bytes + HugePageArena::REGION_SIZE;
+#if defined(__linux__)
+    void* raw = mmap(nullptr, total, PROT_READ | PROT_WRITE,
+        MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (raw == MAP_FAILED) return nullptr;
+
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+    std::uintptr_t aligned = (address + HugePageArena::REGION_SIZE - 1) & ~std::uintptr_t(HugePageArena::REGION_SIZE - 1);
+    if (aligned > address) munmap(raw, aligned - address);
+    std::uintptr_t tail = aligned + bytes;
+    if (address + total > tail) munmap(reinterpret_cast<void*>(tail), address + total - tail);
+
+    char* begin = reinterpret_cast<char*>(aligned);
+#ifdef MADV_HUGEPAGE
+    advised = madvise(begin, bytes, MADV_HUGEPAGE) == 0;
+#endif
+    return begin;
+#elif defined(_WIN32)
+    void* raw = VirtualAlloc(nullptr, total, MEM_RESERVE, PAGE_NOACCESS);
+    if (!raw) return nullptr;
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(raw);
+    std::uintptr_t aligned = (address + HugePageArena::REGION_SIZE - 1) & ~std::uintptr_t(HugePageArena::REGION_SIZE - 1);
+    return reinterpret_cast<char*>(aligned);
+#else
+    (void)total;
+    return nullptr;
+#endif
+}
+
+/**
+ * @brief Выдача потоку следующего региона
+ * @param arena Состояние потока
+ * @return false, если диапазон исчерпан
+ */
+static bool refill(ThreadArena& arena) {
+    char* begin = rangeBegin.load(std::memory_order_acquire);
+    size_t capacity = static_cast<size_t>(rangeEnd.load(std::memory_order_acquire) - begin);
+    size_t offset = nextRegion.fetch_add(HugePageArena::REGION_SIZE, std::memory_order_relaxed);
+    if (offset + HugePageArena::REGION_SIZE > capacity) return false;
+
+    char* region = begin + offset;
+#if defined(_WIN32)
+    if (!VirtualAlloc(region, HugePageArena::REGION_SIZE, MEM_COMMIT, PAGE_READWRITE)) return false;
+#endif
+    arena.cursor = region;
+    arena.end = region + HugePageArena::REGION_SIZE;
+    return true;
+}
+
+bool HugePageArena::enable(size_t reserveBytes) {
+    std::lock_guard<std::mutex> lock(reserveMutex);
+    if (!rangeBegin.load(std::memory_order_acquire)) {
+        if (reserveBytes == 0) {
+            reserveBytes = size_t(1) << (sizeof(void*) >= 8 ? 35 : 28);
+        }
+        reserveBytes = (reserveBytes + REGION_SIZE - 1) / REGION_SIZE * REGION_SIZE;
+        char* begin = reserveRange(reserveBytes);
+        if (!begin) return false;
+        rangeEnd.store(begin + reserveBytes, std::memory_order_release);
+        rangeBegin.store(begin, std::memory_order_release);
+    }
+    enabled.store(true, std::memory_order_release);
+    return true;
+}
+
+void HugePageArena::disable() {
+    enabled.store(false, std::memory_order_release);
+}
+
+bool HugePageArena::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+void* HugePageArena::allocate(size_t bytes) {
+    if (!enabled.load(std::memory_order_relaxed) || bytes == 0 || bytes > MAX_BLOCK) return nullptr;
+
+    size_t sizeClass = (bytes + 15) / 16;
+    ThreadArena& arena = threadArena;
+    void*& head = arena.freeLists[sizeClass - 1];
+    if (head) {
+        void* block = head;
+        head = *static_cast<void**>(block);
+        return block;
+    }
+
+    size_t size = sizeClass * 16;
+    if (static_cast<size_t>(arena.end - arena.cursor) < size && !refill(arena)) return nullptr;
+    void* block = arena.cursor;
+    arena.cursor += size;
+    return block;
+}
+
+/**
+ * @brief Возврат блока в арену
+ *
+ * @details
+ * Блок кладется в список свободных блоков своего класса в текущем потоке
+ * (не обязательно в том, что его выделил): память арены общая, а список
+ * без синхронизации, потому что принадлежит одному потоку.
+ */
+bool HugePageArena::deallocate(void* pointer, size_t bytes) {
+    if (!contains(pointer)) return false;
+
+    size_t sizeClass = (bytes + 15) / 16;
+    void*& head = threadArena.freeLists[sizeClass - 1];
+    *static_cast<void**>(pointer) = head;
+    head = pointer;
+    return true;
+}
+
+bool HugePageArena::contains(const void* pointer) {
+    const char* address = static_cast<const char*>(pointer);
+    return address >= rangeBegin.load(std::memory_order_relaxed)
+        && address < rangeEnd.load(std::memory_order_relaxed);
+}
+
+size_t HugePageArena::usedBytes() {
+    char* begin = rangeBegin.load(std::memory_order_acquire);
+    if (!begin) return 0;
+    size_t capacity = static_cast<size_t>(rangeEnd.load(std::memory_order_acquire) - begin);
+    size_t used = nextRegion.load(std::memory_order_relaxed);
+    return used < capacity ? used : capacity;
+}
+
+bool HugePageArena::hugePagesAdvised() {
+    return advised.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,87 @@
+﻿#ifndef HUGE_PAGE_ARENA_H
+#define HUGE_PAGE_ARENA_H
+
+#include <cstddef>
+
+/**
+ * @file huge_page_arena.h
+ * @brief Арена узлов в регионах по 2 МиБ с прозрачными большими страницами
+ *
+ * При случайном поиске в дереве из 10^7 узлов почти каждый шаг спуска
+ * попадает на новую страницу 4 КиБ и промахивается мимо TLB. Если узлы
+ * лежат в регионах, выровненных на 2 МиБ и отданных под большие страницы
+ * (Linux: mmap + madvise(MADV_HUGEPAGE)), одна запись TLB покрывает
+ * в 512 раз больше узлов.
+ *
+ * Арена включается явно (enable) и используется NodeMemory для блоков
+ * до MAX_BLOCK байт: узлов TreeNode, DBNode и небольших массивов DBNode.
+ * Диапазон адресов резервируется один раз, поэтому принадлежность блока
+ * арене проверяется сравнением адреса с границами - блоки, выделенные до
+ * включения или после выключения, освобождаются как обычно.
+ *
+ * Каждый поток нарезает блоки из собственного региона и держит свои
+ * списки освобожденных блоков по классам размеров (кратно 16 байтам).
+ * Память арены не возвращается системе до завершения программы, а блоки
+ * из списков завершившегося потока больше не переиспользуются.
+ *
+ * Windows: диапазон резервируется VirtualAlloc, регионы подтверждаются
+ * по мере надобности (большие страницы требуют привилегии
+ * SeLockMemoryPrivilege, поэтому используются обычные). На других
+ * платформах enable() возвращает false.
+ */
+class HugePageArena {
+public:
+    /// Размер региона (большой страницы)
+    static const size_t REGION_SIZE = size_t(2) << 20;
+
+    /// Наибольший блок, выделяемый из арены
+    static const size_t MAX_BLOCK = 1024;
+
+    /**
+     * @brief Включение арены
+     * @param reserveBytes Размер резервируемого диапазона адресов (0 - по умолчанию:
+     *        32 ГиБ в 64-битной сборке, 256 МиБ в 32-битной)
+     * @return true если арена доступна (диапазон резервируется при первом вызове)
+     */
+    static bool enable(size_t reserveBytes = 0);
+
+    /**
+     * @brief Выключение арены: новые блоки выделяются из кучи
+     *
+     * @note Уже выделенные из арены блоки остаются действительными.
+     */
+    static void disable();
+
+    /// Выделяются ли новые блоки из арены
+    static bool isEnabled();
+
+    /**
+     * @brief Выделение блока из арены
+     * @param bytes Размер блока
+     * @return Блок с выравниванием 16 или nullptr (арена выключена,
+     *         блок больше MAX_BLOCK или диапазон исчерпан)
+     */
+    static void* allocate(size_t bytes);
+
+    /**
+     * @brief Возврат блока в арену
+     * @param pointer Указатель на блок
+     * @param bytes Размер блока, переданный в allocate
+     * @return false, если блок выделен не из арены
+     */
+    static bool deallocate(void* pointer, size_t bytes);
+
+    /**
+     * @brief Принадлежит ли адрес диапазону арены
+     * @param pointer Адрес
+     */
+    static bool contains(const void* pointer);
+
+    /// Байт в выданных потокам регионах
+    static size_t usedBytes();
+
+    /// Приняло ли ядро совет использовать большие страницы
+    static bool hugePagesAdvised();
+};
+
+#endif // HUGE_PAGE_ARENA_H
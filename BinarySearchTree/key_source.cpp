@@ -0,0 +1,161 @@
+﻿/**
+ * @file key_source.cpp
+ * @brief Реализация потоковых источников ключей
+ */
+
+#include "key_source.h"
+#include "data_generator.h"
+
+#include <algorithm>
+#include <iostream>
+
+// ================== KeyReader ==================
+
+KeyReader::KeyReader(KeySource& source, size_t chunkSize)
+    : source(source), chunkSize(chunkSize), position(0),
+      started(false), ascending(true), previous(0) {
+}
+
+/**
+ * @brief Следующий ключ
+ *
+ * Когда порция исчерпана, запрашивает у источника следующую в тот же буфер.
+ */
+bool KeyReader::next(int& key) {
+    if (position == chunk.size()) {
+        if (!source.nextChunk(chunk, chunkSize)) return false;
+        position = 0;
+    }
+    key = chunk[position++];
+    if (started && key <= previous) ascending = false;
+    previous = key;
+    started = true;
+    return true;
+}
+
+// ================== VectorKeySource ==================
+
+VectorKeySource::VectorKeySource(const std::vector<int>& data)
+    : data(data), position(0) {
+}
+
+bool VectorKeySource::nextChunk(std::vector<int>& chunk, size_t maxCount) {
+    size_t end = std::min(data.size(), position + maxCount);
+    chunk.assign(data.begin() + position, data.begin() + end);
+    position = end;
+    return !chunk.empty();
+}
+
+// ================== GeneratedKeySource ==================
+
+GeneratedKeySource::GeneratedKeySource(int count, int minVal, int maxVal, unsigned long long seed)
+    : count(count), minVal(minVal), maxVal(maxVal), seed(seed), position(0) {
+    long long available = static_cast<long long>(maxVal) - minVal + 1;
+    if (this->count < 0 || available <= 0) this->count = 0;
+    if (this->count > available) this->count = static_cast<int>(available);
+    this->seed = DataGenerator::resolveSeed(seed);
+}
+
+/**
+ * @brief Следующая порция уникальных ключей
+ *
+ * Ключи с индексами [position, position + n) вычисляются
+ * DataGenerator::generateUniqueChunk по индексу, без предыдущих.
+ * Порция генерируется в вызывающем потоке: запуск пула потоков
+ * на каждую порцию дороже самой генерации.
+ */
+bool GeneratedKeySource::nextChunk(std::vector<int>& chunk, size_t maxCount) {
+    int n = static_cast<int>(std::min(static_cast<size_t>(count - position), maxCount));
+    DataGenerator::generateUniqueChunk(chunk, position, n, minVal, maxVal, seed, 1);
+    position += n;
+    return n > 0;
+}
+
+// ================== FileKeySource ==================
+
+FileKeySource::FileKeySource(const std::string& path)
+    : file(std::fopen(path.c_str(), "rb")) {
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось открыть файл ключей " << path << std::endl;
+    }
+}
+
+FileKeySource::~FileKeySource() {
+    if (file) std::fclose(file);
+}
+
+bool FileKeySource::nextChunk(std::vector<int>& chunk, size_t maxCount) {
+    chunk.resize(file ? maxCount : 0);
+    size_t read = file ? std::fread(chunk.data(), sizeof(int), maxCount, file) : 0;
+    chunk.resize(read);
+    return read > 0;
+}
+
+/**
+ * @brief Запись всех ключей источника в двоичный файл
+ *
+ * Пишет порциями, поэтому большой файл можно создать из генератора
+ * без материализации всех ключей.
+ */
+long long FileKeySource::write(const std::string& path, KeySource& source) {
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) {
+        std::cerr << "Предупреждение: не удалось создать файл ключей " << path << std::endl;
+        return -1;
+    }
+
+    long long written = 0;
+    std::vector<int> chunk;
+    while (source.nextChunk(chunk, DEFAULT_CHUNK_SIZE)) {
+        written += std::fwrite(chunk.data(), sizeof(int), chunk.size(), out);
+    }
+    std::fclose(out);
+    return written;
+}
+
+// ================== PrefetchingKeySource ==================
+
+PrefetchingKeySource::PrefetchingKeySource(KeySource& inner)
+    : inner(inner), exhausted(false) {
+}
+
+PrefetchingKeySource::~PrefetchingKeySource() {
+    // Фоновая задача обращается к inner: дожидаемся ее до разрушения
+    if (pending.valid()) pending.wait();
+}
+
+/**
+ * @brief Следующая порция с предвыборкой
+ *
+ * Забирает готовую порцию и сразу запускает чтение следующей в буфер,
+ * который потребитель только что вернул. Первая порция читается без
+ * перекрытия.
+ */
+bool PrefetchingKeySource::nextChunk(std::vector<int>& chunk, size_t maxCount) {
+    if (!pending.valid()) {
+        if (exhausted) {
+            chunk.clear();
+            return false;
+        }
+        startFetch(std::vector<int>(), maxCount);
+    }
+
+    std::vector<int> ready = pending.get();
+    if (ready.empty()) {
+        exhausted = true;
+        chunk.clear();
+        return false;
+    }
+
+    chunk.swap(ready);
+    startFetch(std::move(ready), maxCount);
+    return true;
+}
+
+void PrefetchingKeySource::startFetch(std::vector<int> buffer, size_t maxCount) {
+    KeySource* source = &inner;
+    pending = std::async(std::launch::async, [source, maxCount](std::vector<int> buffer) {
+        source->nextChunk(buffer, maxCount);
+        return buffer;
+    }, std::move(buffer));
+}
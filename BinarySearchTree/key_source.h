@@ -0,0 +1,151 @@
+﻿#ifndef KEY_SOURCE_H
+#define KEY_SOURCE_H
+
+#include <cstddef>
+#include <cstdio>
+#include <future>
+#include <string>
+#include <vector>
+
+/**
+ * @file key_source.h
+ * @brief Потоковые источники ключей для построения деревьев
+ *
+ * Источник отдает ключи порциями по запросу потребителя (pull), поэтому
+ * дерево можно строить из генератора или файла, не держа весь набор
+ * ключей в памяти рядом с деревом.
+ */
+
+class KeySource {
+public:
+    /// Размер порции по умолчанию
+    static const size_t DEFAULT_CHUNK_SIZE = 1 << 16;
+
+    virtual ~KeySource() {}
+
+    /**
+     * @brief Следующая порция ключей
+     * @param chunk Буфер порции (очищается и заполняется, емкость переиспользуется)
+     * @param maxCount Максимальный размер порции
+     * @return false, если ключи закончились (chunk пуст)
+     */
+    virtual bool nextChunk(std::vector<int>& chunk, size_t maxCount) = 0;
+};
+
+/**
+ * @brief Поштучное чтение ключей из источника
+ *
+ * Держит в памяти одну порцию. Попутно отмечает, шли ли ключи
+ * строго по возрастанию (нужно для проверки входа ИСДП).
+ */
+class KeyReader {
+public:
+    explicit KeyReader(KeySource& source, size_t chunkSize = KeySource::DEFAULT_CHUNK_SIZE);
+
+    /**
+     * @brief Следующий ключ
+     * @param key Прочитанный ключ
+     * @return false, если ключи закончились
+     */
+    bool next(int& key);
+
+    /// Все прочитанные ключи шли строго по возрастанию
+    bool isAscending() const { return ascending; }
+
+private:
+    KeySource& source;
+    size_t chunkSize;
+    std::vector<int> chunk;
+    size_t position;
+    bool started;
+    bool ascending;
+    int previous;
+};
+
+/**
+ * @brief Источник поверх готового вектора (вектор не копируется)
+ */
+class VectorKeySource : public KeySource {
+public:
+    explicit VectorKeySource(const std::vector<int>& data);
+    bool nextChunk(std::vector<int>& chunk, size_t maxCount) override;
+
+private:
+    const std::vector<int>& data;
+    size_t position;
+};
+
+/**
+ * @brief Источник уникальных случайных ключей
+ *
+ * Выдает ту же последовательность, что DataGenerator::generateUniqueNumbers
+ * с тем же seed, но порциями: дополнительная память - одна порция.
+ */
+class GeneratedKeySource : public KeySource {
+public:
+    /**
+     * @param count Количество ключей
+     * @param minVal Минимальное значение
+     * @param maxVal Максимальное значение
+     * @param seed Зерно генератора (0 - случайное зерно)
+     */
+    GeneratedKeySource(int count, int minVal, int maxVal, unsigned long long seed = 0);
+    bool nextChunk(std::vector<int>& chunk, size_t maxCount) override;
+
+private:
+    int count;
+    int minVal;
+    int maxVal;
+    unsigned long long seed;
+    int position;
+};
+
+/**
+ * @brief Источник ключей из двоичного файла (32-битные int подряд)
+ */
+class FileKeySource : public KeySource {
+public:
+    explicit FileKeySource(const std::string& path);
+    ~FileKeySource() override;
+    bool nextChunk(std::vector<int>& chunk, size_t maxCount) override;
+
+    /// Файл успешно открыт
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * @brief Запись всех ключей источника в двоичный файл
+     * @param path Путь к файлу
+     * @param source Источник ключей
+     * @return Количество записанных ключей (-1 при ошибке открытия)
+     */
+    static long long write(const std::string& path, KeySource& source);
+
+private:
+    std::FILE* file;
+};
+
+/**
+ * @brief Источник с предвыборкой следующей порции
+ *
+ * Пока потребитель обрабатывает текущую порцию, следующая читается
+ * из вложенного источника в отдельной задаче (std::async) в освободившийся
+ * буфер предыдущей порции - двойная буферизация.
+ *
+ * @note Вложенный источник вызывается только из фоновой задачи и только
+ *       одной задачей за раз.
+ */
+class PrefetchingKeySource : public KeySource {
+public:
+    explicit PrefetchingKeySource(KeySource& inner);
+    ~PrefetchingKeySource() override;
+    bool nextChunk(std::vector<int>& chunk, size_t maxCount) override;
+
+private:
+    KeySource& inner;
+    std::future<std::vector<int>> pending;
+    bool exhausted;
+
+    void startFetch(std::vector<int> buffer, size_t maxCount);
+};
+
+#endif // KEY_SOURCE_H
@@ -8,45 +8,24 @@
 #include "tree_builders.h"
 #include "tree_properties.h"
 #include "output_utils.h"
+#include "output_sink.h"
+#include "tree_traversal.h"
 #include "theory_calculations.h"
 #include "testing.h"
+#include "op_stats.h"
+#include "node_memory.h"
 
 #include <iostream>
 #include <vector>
 #include <algorithm>
 
- /**
-  * @brief    
-  * @param traversal    
-  */
-static void printCompactTraversal(const std::vector<int>& traversal) {
-    if (traversal.size() <= 15) {
-        for (int key : traversal) std::cout << key << " ";
-    }
-    else {
-        for (int i = 0; i < 5; i++) std::cout << traversal[i] << " ";
-        std::cout << "... ";
-
-        int step = traversal.size() / 6;
-        for (int i = 1; i <= 5; i++) {
-            std::cout << traversal[i * step] << " ";
-            if (i < 5) std::cout << "... ";
-        }
-        std::cout << "... ";
-
-        for (int i = traversal.size() - 5; i < traversal.size(); i++) {
-            std::cout << traversal[i] << " ";
-        }
-    }
-    std::cout << std::endl;
-}
-
 /**
- * @brief     
- * @param sizes     
+ * @brief     
+ * @param sizes   
  */
-static void compareTreeCharacteristics(const std::vector<int>& sizes) {
-    std::cout << "===    ===" << std::endl;
+static void printTraversals(const std::vector<int>& sizes) {
+    std::ostream& out = OutputSink::report();
+    out << "===    ===\n";
 
     for (int size : sizes) {
         std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10);
@@ -56,61 +35,91 @@ static void compareTreeCharacteristics(const std::vector<int>& sizes) {
         TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sortedData);
         TreeNode* spTree = TreeBuilders::buildRandomSearchTree(data);
 
-        std::cout << " " << size << ": ";
-        printCompactTraversal(TreeProperties::inOrderTraversal(ibTree));
+        out << " " << size << ": ";
+        OutputUtils::printTraversalSample(TreeTraversal::sampleInOrder(ibTree));
 
-        std::cout << " " << size << ": ";
-        printCompactTraversal(TreeProperties::inOrderTraversal(spTree));
-        std::cout << std::endl;
+        out << " " << size << ": ";
+        OutputUtils::printTraversalSample(TreeTraversal::sampleInOrder(spTree));
+        out << '\n';
 
         TreeBuilders::deleteTree(ibTree);
         TreeBuilders::deleteTree(spTree);
     }
+}
 
-    std::cout << "===   ===" << std::endl << std::endl;
+/**
+ * @brief     
+ * @param sizes     
+ * @param distribution    (   )
+ */
+static void compareTreeCharacteristics(const std::vector<int>& sizes, KeyDistribution distribution) {
+    std::ostream& out = OutputSink::report();
+    out << "===  : "
+        << DataGenerator::distributionName(distribution) << " ===\n\n";
     OutputUtils::printTableHeader("", "");
 
     for (int size : sizes) {
-        std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10);
+        std::vector<int> data = DataGenerator::generateKeys(distribution, size, 1, size * 10);
         std::vector<int> sortedData = data;
         std::sort(sortedData.begin(), sortedData.end());
 
-        TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sortedData);
-        TreeNode* spTree = TreeBuilders::buildRandomSearchTree(data);
+        TreeDigest ibDigest;
+        TreeDigest spDigest;
+        OpStats::current().reset();
+        MemoryStats memoryMark = NodeMemory::mark();
+        TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sortedData, &ibDigest);
+        OpStats ibOps = OpStats::collect();
+        MemoryStats ibMemory = NodeMemory::since(memoryMark);
+
+        memoryMark = NodeMemory::mark();
+        TreeNode* spTree = TreeBuilders::buildRandomSearchTree(data, &spDigest);
+        OpStats spOps = OpStats::collect();
+        MemoryStats spMemory = NodeMemory::since(memoryMark);
+
+        //    :    O(1)
+        if (ibDigest != spDigest) {
+            std::cerr << ":      !" << std::endl;
+        }
 
-        int ibCheckSum = TreeProperties::calculateCheckSum(ibTree);
-        int ibHeight = TreeProperties::calculateHeight(ibTree);
+        TreeStats ibStats = TreeProperties::calculateStats(ibTree);
         double ibTheoreticalAvgHeight = TheoryCalculations::theoreticalAverageHeightBalanced(size);
 
-        int spCheckSum = TreeProperties::calculateCheckSum(spTree);
-        int spHeight = TreeProperties::calculateHeight(spTree);
+        TreeStats spStats = TreeProperties::calculateStats(spTree);
         double spTheoreticalAvgHeight = TheoryCalculations::theoreticalAverageHeightRandomBST(size);
 
         OutputUtils::printTableRow(size,
-            spCheckSum, spHeight, spTheoreticalAvgHeight,
-            ibCheckSum, ibHeight, ibTheoreticalAvgHeight);
+            spDigest.checkSum, spStats.height, spTheoreticalAvgHeight, spMemory.bytesPerKey(spDigest.count),
+            ibDigest.checkSum, ibStats.height, ibTheoreticalAvgHeight, ibMemory.bytesPerKey(ibDigest.count));
+        OutputUtils::printMemoryRow("", spMemory, "", ibMemory);
+        OutputUtils::printOpStatsRow("", spOps, "", ibOps);
 
         TreeBuilders::deleteTree(ibTree);
         TreeBuilders::deleteTree(spTree);
     }
 
-    std::cout << std::string(100, '=') << std::endl;
+    out << std::string(124, '=') << '\n';
 }
 
 /**
  * @brief     1
  */
 void runLab1() {
-    std::cout << "==================================================" << std::endl;
-    std::cout << "  1" << std::endl;
-    std::cout << ":     ()" << std::endl;
-    std::cout << "           ()" << std::endl;
-    std::cout << "==================================================" << std::endl;
-    std::cout << std::endl;
+    std::ostream& out = OutputSink::report();
+    out << "==================================================\n";
+    out << "  1\n";
+    out << ":     ()\n";
+    out << "           ()\n";
+    out << "==================================================\n";
+    out << '\n';
 
-    std::cout << "       : 100, 200, 300, 400, 500" << std::endl;
-    std::cout << std::endl;
+    out << "       : 100, 200, 300, 400, 500\n";
+    out << '\n';
 
     std::vector<int> sizes = { 100, 200, 300, 400, 500 };
-    compareTreeCharacteristics(sizes);
+    printTraversals(sizes);
+    for (KeyDistribution distribution : DataGenerator::buildDistributions()) {
+        compareTreeCharacteristics(sizes, distribution);
+    }
+
+    out.flush();
 }
\ No newline at end of file
@@ -16,7 +16,7 @@
   * @details
   *        100, 200, 300, 400, 500.
   * :
-  * 1.   
+  * 1.      (. KeyDistribution)
   * 2.  
   * 3.   (,  )
   * 4.    
@@ -6,8 +6,12 @@
 #include "lab2.h"
 #include "data_generator.h"
 #include "tree_builders.h"
+#include "op_stats.h"
+#include "node_memory.h"
 #include "tree_properties.h"
 #include "output_utils.h"
+#include "output_sink.h"
+#include "tree_traversal.h"
 #include "theory_calculations.h"
 #include "testing.h"
 
@@ -15,41 +19,13 @@
 #include <vector>
 #include <algorithm>
 
- /**
-  * @brief    
-  * @param traversal    
-  */
-static void printCompactTraversal(const std::vector<int>& traversal) {
-    if (traversal.size() <= 15) {
-        for (int key : traversal) std::cout << key << " ";
-    }
-    else {
-        for (int i = 0; i < 5; i++) std::cout << traversal[i] << " ";
-        std::cout << "... ";
-
-        int step = traversal.size() / 6;
-        for (int i = 1; i <= 5; i++) {
-            std::cout << traversal[i * step] << " ";
-            if (i < 5) std::cout << "... ";
-        }
-        std::cout << "... ";
-
-        for (int i = traversal.size() - 5; i < traversal.size(); i++) {
-            std::cout << traversal[i] << " ";
-        }
-    }
-    std::cout << std::endl;
-}
-
 /**
- * @brief   -     
- * @param sizes     
- * @details
- *  ,      ,
- *       .
+ * @brief   -  
+ * @param sizes   
  */
-static void compareTreeCharacteristics(const std::vector<int>& sizes) {
-    std::cout << "===    ===" << std::endl;
+static void printTraversals(const std::vector<int>& sizes) {
+    std::ostream& out = OutputSink::report();
+    out << "===    ===\n";
 
     for (int size : sizes) {
         std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10);
@@ -59,46 +35,73 @@ static void compareTreeCharacteristics(const std::vector<int>& sizes) {
         TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
         TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sortedData);
 
-        std::cout << " " << size << ": ";
-        printCompactTraversal(TreeProperties::inOrderTraversal(avlTree));
+        out << " " << size << ": ";
+        OutputUtils::printTraversalSample(TreeTraversal::sampleInOrder(avlTree));
 
-        std::cout << " " << size << ": ";
-        printCompactTraversal(TreeProperties::inOrderTraversal(ibTree));
+        out << " " << size << ": ";
+        OutputUtils::printTraversalSample(TreeTraversal::sampleInOrder(ibTree));
 
-        std::cout << std::endl;
+        out << '\n';
 
         TreeBuilders::deleteTree(avlTree);
         TreeBuilders::deleteTree(ibTree);
     }
+}
 
-    std::cout << "===   ===" << std::endl << std::endl;
+/**
+ * @brief   -     
+ * @param sizes     
+ * @param distribution    (   )
+ * @details
+ *  ,      ,
+ *       .
+ */
+static void compareTreeCharacteristics(const std::vector<int>& sizes, KeyDistribution distribution) {
+    std::ostream& out = OutputSink::report();
+    out << "===  : "
+        << DataGenerator::distributionName(distribution) << " ===\n\n";
     OutputUtils::printTableHeader("", "");
 
     for (int size : sizes) {
-        std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10);
+        std::vector<int> data = DataGenerator::generateKeys(distribution, size, 1, size * 10);
         std::vector<int> sortedData = data;
         std::sort(sortedData.begin(), sortedData.end());
 
-        TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
-        TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sortedData);
+        TreeDigest avlDigest;
+        TreeDigest ibDigest;
+        OpStats::current().reset();
+        MemoryStats memoryMark = NodeMemory::mark();
+        TreeNode* avlTree = TreeBuilders::buildAVLTree(data, &avlDigest);
+        OpStats avlOps = OpStats::collect();
+        MemoryStats avlMemory = NodeMemory::since(memoryMark);
+
+        memoryMark = NodeMemory::mark();
+        TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sortedData, &ibDigest);
+        OpStats ibOps = OpStats::collect();
+        MemoryStats ibMemory = NodeMemory::since(memoryMark);
+
+        //    :    O(1)
+        if (avlDigest != ibDigest) {
+            std::cerr << ":      !" << std::endl;
+        }
 
-        int avlCheckSum = TreeProperties::calculateCheckSum(avlTree);
-        int avlHeight = TreeProperties::calculateHeight(avlTree);
+        TreeStats avlStats = TreeProperties::calculateStats(avlTree);
         double avlAvg = TheoryCalculations::theoreticalAverageHeightBalanced(size);
 
-        int ibCheckSum = TreeProperties::calculateCheckSum(ibTree);
-        int ibHeight = TreeProperties::calculateHeight(ibTree);
+        TreeStats ibStats = TreeProperties::calculateStats(ibTree);
         double ibAvg = TheoryCalculations::theoreticalAverageHeightBalanced(size);
 
         OutputUtils::printTableRow(size,
-            avlCheckSum, avlHeight, avlAvg,
-            ibCheckSum, ibHeight, ibAvg);
+            avlDigest.checkSum, avlStats.height, avlAvg, avlMemory.bytesPerKey(avlDigest.count),
+            ibDigest.checkSum, ibStats.height, ibAvg, ibMemory.bytesPerKey(ibDigest.count));
+        OutputUtils::printMemoryRow("", avlMemory, "", ibMemory);
+        OutputUtils::printOpStatsRow("", avlOps, "", ibOps);
 
         TreeBuilders::deleteTree(avlTree);
         TreeBuilders::deleteTree(ibTree);
     }
 
-    std::cout << std::string(100, '=') << std::endl;
+    out << std::string(124, '=') << '\n';
 }
 
 /**
@@ -108,15 +111,21 @@ static void compareTreeCharacteristics(const std::vector<int>& sizes) {
  *   100, 200, 300, 400, 500.
  */
 void runLab2() {
-    std::cout << "==================================================" << std::endl;
-    std::cout << "  2" << std::endl;
-    std::cout << ":      ()" << std::endl;
-    std::cout << "==================================================" << std::endl;
-    std::cout << std::endl;
+    std::ostream& out = OutputSink::report();
+    out << "==================================================\n";
+    out << "  2\n";
+    out << ":      ()\n";
+    out << "==================================================\n";
+    out << '\n';
 
-    std::cout << "       : 100, 200, 300, 400, 500" << std::endl;
-    std::cout << std::endl;
+    out << "       : 100, 200, 300, 400, 500\n";
+    out << '\n';
 
     std::vector<int> sizes = { 100, 200, 300, 400, 500 };
-    compareTreeCharacteristics(sizes);
+    printTraversals(sizes);
+    for (KeyDistribution distribution : DataGenerator::buildDistributions()) {
+        compareTreeCharacteristics(sizes, distribution);
+    }
+
+    out.flush();
 }
\ No newline at end of file
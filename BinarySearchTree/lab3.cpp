@@ -7,8 +7,12 @@
 #include "db_node.h"
 #include "data_generator.h"
 #include "tree_builders.h"
+#include "op_stats.h"
+#include "node_memory.h"
 #include "tree_properties.h"
 #include "output_utils.h"
+#include "output_sink.h"
+#include "tree_traversal.h"
 #include "theory_calculations.h"
 #include "testing.h"
 
@@ -16,39 +20,13 @@
 #include <vector>
 #include <algorithm>
 
- /**
-  * @brief Компактный вывод обхода дерева
-  * @param traversal Вектор ключей для вывода
-  */
-static void printCompactTraversal(const std::vector<int>& traversal) {
-    if (traversal.size() <= 15) {
-        for (int key : traversal) std::cout << key << " ";
-    }
-    else {
-        for (int i = 0; i < 5; i++) std::cout << traversal[i] << " ";
-        std::cout << "... ";
-
-        int step = traversal.size() / 6;
-        for (int i = 1; i <= 5; i++) {
-            std::cout << traversal[i * step] << " ";
-            if (i < 5) std::cout << "... ";
-        }
-
-        std::cout << "... ";
-
-        for (int i = traversal.size() - 5; i < traversal.size(); i++) {
-            std::cout << traversal[i] << " ";
-        }
-    }
-    std::cout << std::endl;
-}
-
 /**
- * @brief Сравнение характеристик АВЛ-дерева и B-дерева
- * @param sizes Вектор размеров деревьев для анализа
+ * @brief Вывод обходов АВЛ-дерева и B-дерева
+ * @param sizes Вектор размеров деревьев
  */
-static void compareDBDCharacteristics(const std::vector<int>& sizes) {
-    std::cout << "=== ВЫВОД ОБХОДОВ ДЕРЕВЬЕВ ===" << std::endl;
+static void printTraversals(const std::vector<int>& sizes) {
+    std::ostream& out = OutputSink::report();
+    out << "=== ВЫВОД ОБХОДОВ ДЕРЕВЬЕВ ===\n";
 
     for (int size : sizes) {
         std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10);
@@ -56,60 +34,88 @@ static void compareDBDCharacteristics(const std::vector<int>& sizes) {
         TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
         DBNode* dbTree = TreeBuilders::buildDBTree(data, 2);
 
-        std::cout << "АВЛ " << size << ": ";
-        printCompactTraversal(TreeProperties::inOrderTraversal(avlTree));
+        out << "АВЛ " << size << ": ";
+        OutputUtils::printTraversalSample(TreeTraversal::sampleInOrder(avlTree));
 
-        std::vector<int> dbTraversal;
-        TreeBuilders::inOrderTraversalDB(dbTree, dbTraversal);
-        std::cout << "ДБД " << size << ": ";
-        printCompactTraversal(dbTraversal);
+        out << "ДБД " << size << ": ";
+        OutputUtils::printTraversalSample(TreeTraversal::sampleInOrder(dbTree));
 
         TreeBuilders::deleteTree(avlTree);
         TreeBuilders::deleteDBTree(dbTree);
     }
+}
 
-    std::cout << std::endl << "=== СРАВНЕНИЕ ХАРАКТЕРИСТИК ===" << std::endl;
+/**
+ * @brief Сравнение характеристик АВЛ-дерева и B-дерева
+ * @param sizes Вектор размеров деревьев для анализа
+ * @param distribution Форма входных данных (порядок вставки)
+ */
+static void compareDBDCharacteristics(const std::vector<int>& sizes, KeyDistribution distribution) {
+    std::ostream& out = OutputSink::report();
+    out << '\n' << "=== СРАВНЕНИЕ ХАРАКТЕРИСТИК: "
+        << DataGenerator::distributionName(distribution) << " ===\n";
     OutputUtils::printDBTableHeader();
 
     for (int size : sizes) {
-        std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10);
-
-        TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
-        DBNode* dbTree = TreeBuilders::buildDBTree(data, 2);
+        std::vector<int> data = DataGenerator::generateKeys(distribution, size, 1, size * 10);
+
+        TreeDigest avlDigest;
+        TreeDigest dbDigest;
+        OpStats::current().reset();
+        MemoryStats memoryMark = NodeMemory::mark();
+        TreeNode* avlTree = TreeBuilders::buildAVLTree(data, &avlDigest);
+        OpStats avlOps = OpStats::collect();
+        MemoryStats avlMemory = NodeMemory::since(memoryMark);
+
+        memoryMark = NodeMemory::mark();
+        DBNode* dbTree = TreeBuilders::buildDBTree(data, 2, &dbDigest);
+        OpStats dbOps = OpStats::collect();
+        MemoryStats dbMemory = NodeMemory::since(memoryMark);
+
+        // Дайджесты накоплены при построении: сравнение содержимого за O(1)
+        if (avlDigest != dbDigest) {
+            std::cerr << "Предупреждение: наборы ключей АВЛ и ДБД различаются!" << std::endl;
+        }
 
-        int avlCheckSum = TreeProperties::calculateCheckSum(avlTree);
-        int avlHeight = TreeProperties::calculateHeight(avlTree);
+        TreeStats avlStats = TreeProperties::calculateStats(avlTree);
         double avlAvg = TheoryCalculations::theoreticalAverageHeightBalanced(size);
 
-        int dbCheckSum = TreeProperties::calculateCheckSumDB(dbTree);
-        int dbHeight = TreeProperties::calculateHeightDB(dbTree);
+        TreeStats dbStats = TreeProperties::calculateStatsDB(dbTree);
         double dbHeightTheo = TheoryCalculations::theoreticalDBHeight(size, 2);
         double dbAvgTheo = TheoryCalculations::theoreticalAverageHeightBalanced(size);
 
         OutputUtils::printDBTableRow(size,
-            avlCheckSum, avlHeight, avlAvg,
-            dbCheckSum, dbHeight, dbHeightTheo, dbAvgTheo);
+            avlDigest.checkSum, avlStats.height, avlAvg, avlMemory.bytesPerKey(avlDigest.count),
+            dbDigest.checkSum, dbStats.height, dbHeightTheo, dbAvgTheo, dbMemory.bytesPerKey(dbDigest.count));
+        OutputUtils::printMemoryRow("АВЛ", avlMemory, "ДБД", dbMemory);
+        OutputUtils::printOpStatsRow("АВЛ", avlOps, "ДБД", dbOps);
 
         TreeBuilders::deleteTree(avlTree);
         TreeBuilders::deleteDBTree(dbTree);
     }
 
-    std::cout << std::string(90, '=') << std::endl;
+    out << std::string(110, '=') << '\n';
 }
 
 /**
  * @brief Основная функция лабораторной работы 3
  */
 void runLab3() {
-    std::cout << "==================================================" << std::endl;
-    std::cout << "ЛАБОРАТОРНАЯ РАБОТА 3" << std::endl;
-    std::cout << "Тема: Двоичное Б-дерево поиска (ДБД)" << std::endl;
-    std::cout << "==================================================" << std::endl;
-    std::cout << std::endl;
+    std::ostream& out = OutputSink::report();
+    out << "==================================================\n";
+    out << "ЛАБОРАТОРНАЯ РАБОТА 3\n";
+    out << "Тема: Двоичное Б-дерево поиска (ДБД)\n";
+    out << "==================================================\n";
+    out << '\n';
 
-    std::cout << "Построение и сравнение АВЛ и ДБД для размеров: 100, 200, 300, 400, 500" << std::endl;
-    std::cout << std::endl;
+    out << "Построение и сравнение АВЛ и ДБД для размеров: 100, 200, 300, 400, 500\n";
+    out << '\n';
 
     std::vector<int> sizes = { 100, 200, 300, 400, 500 };
-    compareDBDCharacteristics(sizes);
+    printTraversals(sizes);
+    for (KeyDistribution distribution : DataGenerator::buildDistributions()) {
+        compareDBDCharacteristics(sizes, distribution);
+    }
+
+    out.flush();
 }
\ No newline at end of file
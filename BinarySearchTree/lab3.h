@@ -15,7 +15,8 @@
   *
   * @details
   *   -  B- (t=2)
-  *   100, 200, 300, 400, 500.
+  *   100, 200, 300, 400, 500     
+  * (. KeyDistribution).
   */
 void runLab3();
 
@@ -3,11 +3,35 @@
  * @brief        
  */
 
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include "lab1.h"
 #include "lab2.h"
 #include "lab3.h"
 #include "tests.h"
+#include "benchmarks.h"
+#include "huge_page_arena.h"
+#include "output_sink.h"
+
+/**
+ * @brief     std::cout   main()
+ *
+ * @details
+ *    OutputSink::console(),   
+ *  std::cout    (std::cout.tie). console() -
+ *      ,  
+ *     ,   
+ *  main()  ,   .
+ */
+struct ConsoleTie {
+    ConsoleTie() { std::cout.tie(&OutputSink::console()); }
+    ~ConsoleTie() {
+        OutputSink::console().flush();
+        std::cout.tie(nullptr);
+    }
+};
 
  /**
   * @brief    
@@ -19,12 +43,45 @@
   * 2.  2:    
   * 3.  3:    
   * 4.  
+  * 5.  
+  * 6.  (, , , )
   * 0.   
+  *
+  *    "--microbench [k]"  
+  *   10^3..10^k (  k = 6)  .
+  *     "--huge-pages":   
+  *       (HugePageArena).
+  *    "--report <>":    
+  *     ,    .
   */
-int main() {
+int main(int argc, char* argv[]) {
     //       
     std::locale::global(std::locale(""));
     std::cout.imbue(std::locale());
+    ConsoleTie consoleTie;
+
+    int arg = 1;
+    if (arg < argc && std::strcmp(argv[arg], "--huge-pages") == 0) {
+        if (!HugePageArena::enable()) {
+            // std::cerr     :   
+            OutputSink::console().flush();
+            std::cerr << ":     ,    " << std::endl;
+        }
+        arg++;
+    }
+
+    std::unique_ptr<OutputSink> reportFile;
+    if (arg + 1 < argc && std::strcmp(argv[arg], "--report") == 0) {
+        reportFile.reset(new OutputSink(argv[arg + 1]));
+        if (reportFile->isOpen()) OutputSink::setReport(reportFile.get());
+        arg += 2;
+    }
+
+    if (arg < argc && std::strcmp(argv[arg], "--microbench") == 0) {
+        int maxExponent = arg + 1 < argc ? std::atoi(argv[arg + 1]) : 6;
+        runMicrobenchmarks(MicrobenchmarkConfig::upTo(maxExponent));
+        return 0;
+    }
 
     while (true) {
         //  
@@ -35,6 +92,8 @@ int main() {
         std::cout << "2.  2 (  )\n";
         std::cout << "3.  3 (  )\n";
         std::cout << "4. \n";
+        std::cout << "5.  \n";
+        std::cout << "6. \n";
         std::cout << "0. \n";
         std::cout << "--------------------------------------------------\n";
         std::cout << " : ";
@@ -60,6 +119,18 @@ int main() {
             runTests();
             break;
 
+        case 5:
+            runBenchmarks();
+            break;
+
+        case 6: {
+            std::cout << "  10^k, k (3..8): ";
+            int maxExponent;
+            std::cin >> maxExponent;
+            runMicrobenchmarks(MicrobenchmarkConfig::upTo(maxExponent));
+            break;
+        }
+
         case 0:
             return 0;
 
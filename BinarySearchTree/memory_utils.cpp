@@ -10,40 +10,217 @@
 
 #include "memory_utils.h"
 #include <iostream>
-#include <unordered_set>
 
- //      (  )
 #ifdef DEBUG_MEMORY
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <unordered_set>
+
 /**
- * @brief     
+ * @brief    (  )
+ *
+ * @details
+ *   std::unordered_set:      
+ *       ,    
+ *       .
+ *
+ * :
+ * - SHARD_COUNT ,      ;
+ *          ,    
+ * -   -       ,
+ *        
+ * -      ""  CAS, 
+ *       CAS;    
+ *    ,       
+ * -   MAX_PROBE   ,    
+ *      ; ,     ,
+ *      . ,     ,   ,
+ *     (    )
+ */
+class NodeRegistry {
+public:
+    ~NodeRegistry() {
+        for (Shard& shard : shards) delete[] shard.slots.load();
+    }
+
+    /**
+     * @brief   
+     */
+    void insert(TreeNode* node) {
+        Shard& shard = shardOf(node);
+        std::atomic<TreeNode*>* slots = slotsOf(shard);
+        size_t start = indexOf(node);
+        shard.created.fetch_add(1, std::memory_order_relaxed);
+
+        for (size_t probe = 0; probe < MAX_PROBE; probe++) {
+            std::atomic<TreeNode*>& slot = slots[(start + probe) & (SLOTS_PER_SHARD - 1)];
+            TreeNode* current = slot.load(std::memory_order_relaxed);
+            while (current == nullptr || current == tombstone()) {
+                if (slot.compare_exchange_weak(current, node, std::memory_order_acq_rel)) return;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(shard.overflowMutex);
+        shard.overflow.insert(node);
+    }
+
+    /**
+     * @brief    
+     * @return false,     
+     */
+    bool erase(TreeNode* node) {
+        Shard& shard = shardOf(node);
+        std::atomic<TreeNode*>* slots = slotsOf(shard);
+        size_t start = indexOf(node);
+
+        for (size_t probe = 0; probe < MAX_PROBE; probe++) {
+            std::atomic<TreeNode*>& slot = slots[(start + probe) & (SLOTS_PER_SHARD - 1)];
+            TreeNode* current = slot.load(std::memory_order_acquire);
+            if (current == nullptr) break;
+            if (current == node && slot.compare_exchange_strong(current, tombstone(), std::memory_order_acq_rel)) {
+                shard.deleted.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+
+        //        
+        std::lock_guard<std::mutex> lock(shard.overflowMutex);
+        if (shard.overflow.erase(node) == 0) return false;
+        shard.deleted.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief    (  )
+     */
+    long long liveCount() const {
+        long long live = 0;
+        for (const Shard& shard : shards) {
+            live += shard.created.load(std::memory_order_relaxed) - shard.deleted.load(std::memory_order_relaxed);
+        }
+        return live;
+    }
+
+    /**
+     * @brief   ,    
+     */
+    long long overflowCount() {
+        long long overflow = 0;
+        for (Shard& shard : shards) {
+            std::lock_guard<std::mutex> lock(shard.overflowMutex);
+            overflow += static_cast<long long>(shard.overflow.size());
+        }
+        return overflow;
+    }
+
+    /**
+     * @brief    
+     * @param visit ,  TreeNode*
+     *
+     * @note   -     
+     *           (   ).
+     */
+    template <typename Visit>
+    void forEach(Visit visit) {
+        for (Shard& shard : shards) {
+            std::atomic<TreeNode*>* slots = shard.slots.load(std::memory_order_acquire);
+            if (slots) {
+                for (size_t i = 0; i < SLOTS_PER_SHARD; i++) {
+                    TreeNode* node = slots[i].load(std::memory_order_relaxed);
+                    if (node != nullptr && node != tombstone()) visit(node);
+                }
+            }
+            std::lock_guard<std::mutex> lock(shard.overflowMutex);
+            for (TreeNode* node : shard.overflow) visit(node);
+        }
+    }
+
+    /**
+     * @brief   (  )
+     */
+    void clear() {
+        for (Shard& shard : shards) {
+            std::atomic<TreeNode*>* slots = shard.slots.load(std::memory_order_acquire);
+            if (slots) {
+                for (size_t i = 0; i < SLOTS_PER_SHARD; i++) slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+            shard.created.store(0, std::memory_order_relaxed);
+            shard.deleted.store(0, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(shard.overflowMutex);
+            shard.overflow.clear();
+        }
+    }
+
+private:
+    static const int SHARD_COUNT = 64;
+    static const size_t SLOTS_PER_SHARD = 1 << 16;
+    static const size_t MAX_PROBE = 128;
+
+    struct alignas(64) Shard {
+        std::atomic<std::atomic<TreeNode*>*> slots{ nullptr };
+        std::atomic<long long> created{ 0 };
+        std::atomic<long long> deleted{ 0 };
+        std::mutex overflowMutex;
+        std::unordered_set<TreeNode*> overflow;  // ,    
+    };
+
+    Shard shards[SHARD_COUNT];
+
+    ///    (    )
+    static TreeNode* tombstone() {
+        return reinterpret_cast<TreeNode*>(static_cast<std::uintptr_t>(1));
+    }
+
+    ///   (     - )
+    static unsigned long long hashOf(TreeNode* node) {
+        return (static_cast<unsigned long long>(reinterpret_cast<std::uintptr_t>(node)) >> 4) * 0x9E3779B97F4A7C15ULL;
+    }
+
+    Shard& shardOf(TreeNode* node) {
+        return shards[hashOf(node) >> 58];
+    }
+
+    static size_t indexOf(TreeNode* node) {
+        return static_cast<size_t>(hashOf(node)) & (SLOTS_PER_SHARD - 1);
+    }
+
+    ///  ;     ,  CAS  
+    static std::atomic<TreeNode*>* slotsOf(Shard& shard) {
+        std::atomic<TreeNode*>* slots = shard.slots.load(std::memory_order_acquire);
+        if (slots) return slots;
+        std::atomic<TreeNode*>* fresh = new std::atomic<TreeNode*>[SLOTS_PER_SHARD]();
+        if (shard.slots.compare_exchange_strong(slots, fresh, std::memory_order_acq_rel)) return fresh;
+        delete[] fresh;
+        return slots;
+    }
+};
+
+/**
+ * @brief  ,   MemoryUtils
  *
  * @details
- *       MemoryUtils .
  *      DEBUG_MEMORY.
  *        .
  */
-static std::unordered_set<TreeNode*> allocatedNodes;
+static NodeRegistry allocatedNodes;
 #endif
 
 /**
  * @brief     
  *
  * @details
- *   DEBUG_MEMORY:
- * 1.     
- * 2.   
- * 3.     
+ *   DEBUG_MEMORY      
+ *      -      .
  *
  *        new.
+ *       NodeMemory (TreeNode::operator new).
  */
 TreeNode* MemoryUtils::createTreeNode(int key) {
     TreeNode* node = new TreeNode(key);
 
 #ifdef DEBUG_MEMORY
-    //  :   
     allocatedNodes.insert(node);
-    std::cout << "[MEMORY]   " << node << "   " << key << std::endl;
-    std::cout << "[MEMORY]   : " << allocatedNodes.size() << std::endl;
 #endif
 
     return node;
@@ -53,11 +230,9 @@ TreeNode* MemoryUtils::createTreeNode(int key) {
  * @brief     
  *
  * @details
- *   DEBUG_MEMORY:
- * 1. ,      MemoryUtils
- * 2.    
- * 3.   
- * 4.      
+ *   DEBUG_MEMORY      .  
+ * ,    MemoryUtils (  ),
+ *  .
  *
  *        delete.
  */
@@ -67,14 +242,8 @@ void MemoryUtils::deleteTreeNode(TreeNode* node) {
     }
 
 #ifdef DEBUG_MEMORY
-    //  :    
-    if (allocatedNodes.find(node) != allocatedNodes.end()) {
-        allocatedNodes.erase(node);
-        std::cout << "[MEMORY]   " << node << "   " << node->key << std::endl;
-        std::cout << "[MEMORY]  : " << allocatedNodes.size() << std::endl;
-    }
-    else {
-        std::cout << "[MEMORY] :     " << node << std::endl;
+    if (!allocatedNodes.erase(node)) {
+        std::cerr << "[MEMORY] :     " << node << std::endl;
     }
 #endif
 
@@ -86,23 +255,35 @@ void MemoryUtils::deleteTreeNode(TreeNode* node) {
  *
  * @details
  *   DEBUG_MEMORY:
- * 1. ,    
- * 2.     
+ * 1.     -   
+ * 2.  :  REPORT_LIMIT     
  * 3.   
  *
  *      0.
  *
- * @note        .
+ * @note        ,
+ *                .
  */
 int MemoryUtils::checkMemoryLeaks() {
 #ifdef DEBUG_MEMORY
-    int leaks = allocatedNodes.size();
+    const int REPORT_LIMIT = 20;
+    int leaks = static_cast<int>(allocatedNodes.liveCount());
     if (leaks > 0) {
         std::cout << "[MEMORY]   !" << std::endl;
         std::cout << "[MEMORY]   " << leaks << " :" << std::endl;
 
-        for (TreeNode* node : allocatedNodes) {
-            std::cout << "[MEMORY]    " << node << "   " << node->key << std::endl;
+        int reported = 0;
+        allocatedNodes.forEach([&](TreeNode* node) {
+            if (reported++ < REPORT_LIMIT) {
+                std::cout << "[MEMORY]    " << node << "   " << node->key << std::endl;
+            }
+        });
+        if (reported > REPORT_LIMIT) {
+            std::cout << "[MEMORY]   ...   " << reported - REPORT_LIMIT << std::endl;
+        }
+        long long overflow = allocatedNodes.overflowCount();
+        if (overflow > 0) {
+            std::cout << "[MEMORY]   " << overflow << "     " << std::endl;
         }
     }
     else {
@@ -116,13 +297,20 @@ int MemoryUtils::checkMemoryLeaks() {
 #endif
 }
 
+/**
+ * @brief     
+ */
+MemoryStats MemoryUtils::memoryStats() {
+    return NodeMemory::current();
+}
+
 /**
  * @brief    
  *
  * @details
  *   DEBUG_MEMORY:
  * 1.     
- * 2.   allocatedNodes
+ * 2.   allocatedNodes
  * 3.    
  *
  *        .
@@ -136,11 +324,10 @@ void MemoryUtils::emergencyCleanup() {
     std::cout << "[MEMORY]   ..." << std::endl;
 
     int cleaned = 0;
-    for (TreeNode* node : allocatedNodes) {
-        std::cout << "[MEMORY]    " << node << "   " << node->key << std::endl;
+    allocatedNodes.forEach([&](TreeNode* node) {
         delete node;
         cleaned++;
-    }
+    });
 
     allocatedNodes.clear();
     std::cout << "[MEMORY]  " << cleaned << " " << std::endl;
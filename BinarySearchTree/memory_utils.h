@@ -7,6 +7,7 @@
 #define MEMORY_UTILS_H
 
 #include "tree_node.h"
+#include "node_memory.h"
 
 class MemoryUtils {
 public:
@@ -24,11 +25,19 @@ public:
     static void deleteTreeNode(TreeNode* node);
 
     /**
-     * @brief   
-     * @return   
+     * @brief     
+     * @return    (0  DEBUG_MEMORY)
      */
     static int checkMemoryLeaks();
 
+    /**
+     * @brief     
+     * @return    ,    
+     *
+     *    DEBUG_MEMORY:   NodeMemory.
+     */
+    static MemoryStats memoryStats();
+
     /**
      * @brief    
      */
@@ -0,0 +1,180 @@
+﻿/**
+ * @file node_memory.cpp
+ * @brief Реализация учета памяти узлов
+ */
+
+#include "node_memory.h"
+#include "huge_page_arena.h"
+#include <atomic>
+#include <new>
+
+// Наибольший блок, который кэшируется в списках свободных блоков
+static const std::size_t CACHE_MAX_BLOCK = 256;
+// Классы размеров кэша (блоки кратны 16 байтам)
+static const std::size_t CACHE_CLASSES = CACHE_MAX_BLOCK / 16;
+// Операций выделения/освобождения между подрезками кэша
+static const long long TRIM_INTERVAL = 1 << 16;
+
+static std::atomic<int> cacheLimit{ NodeMemory::DEFAULT_CACHE_LIMIT };
+
+// Счетчики текущего потока
+static thread_local MemoryStats threadStats;
+
+/**
+ * @brief Списки свободных блоков текущего потока
+ *
+ * @details
+ * Блоки из кучи одного класса размера связываются через свое первое слово.
+ * Длина каждого списка ограничена cacheLimit; лишние блоки сразу
+ * возвращаются в кучу.
+ *
+ * Подрезка: раз в TRIM_INTERVAL операций для каждого класса известен
+ * минимум длины списка за период (lowWater) - столько блоков период
+ * пролежали без дела. Половина из них возвращается в кучу. При постоянной
+ * смеси вставок и удалений список не опускается до нуля и почти не
+ * подрезается; после всплеска освобождений кэш за несколько периодов
+ * сходит на нет.
+ */
+struct FreeCache {
+    void* heads[CACHE_CLASSES] = {};
+    int counts[CACHE_CLASSES] = {};
+    int lowWater[CACHE_CLASSES] = {};
+    long long operations = 0;
+
+    ~FreeCache() {
+        for (std::size_t index = 0; index < CACHE_CLASSES; index++) release(index, 0);
+    }
+
+    void* pop(std::size_t index) {
+        void* block = heads[index];
+        if (!block) return nullptr;
+        heads[index] = *static_cast<void**>(block);
+        if (--counts[index] < lowWater[index]) lowWater[index] = counts[index];
+        return block;
+    }
+
+    bool push(std::size_t index, void* block) {
+        if (counts[index] >= cacheLimit.load(std::memory_order_relaxed)) return false;
+        *static_cast<void**>(block) = heads[index];
+        heads[index] = block;
+        counts[index]++;
+        return true;
+    }
+
+    /// Возврат в кучу всех блоков класса сверх keep
+    void release(std::size_t index, int keep) {
+        while (counts[index] > keep) {
+            void* block = heads[index];
+            heads[index] = *static_cast<void**>(block);
+            counts[index]--;
+            ::operator delete(block);
+        }
+        if (lowWater[index] > counts[index]) lowWater[index] = counts[index];
+    }
+
+    void tick() {
+        if (++operations % TRIM_INTERVAL != 0) return;
+        for (std::size_t index = 0; index < CACHE_CLASSES; index++) {
+            release(index, counts[index] - lowWater[index] / 2);
+            lowWater[index] = counts[index];
+        }
+    }
+
+    long long cachedBytes() const {
+        long long bytes = 0;
+        for (std::size_t index = 0; index < CACHE_CLASSES; index++) {
+            bytes += static_cast<long long>(counts[index]) * (index + 1) * 16;
+        }
+        return bytes;
+    }
+};
+
+static thread_local FreeCache threadCache;
+
+/**
+ * @brief Индекс класса размера в кэше
+ * @return Индекс или CACHE_CLASSES, если блок не кэшируется
+ */
+static std::size_t cacheIndex(std::size_t bytes) {
+    if (bytes == 0 || bytes > CACHE_MAX_BLOCK) return CACHE_CLASSES;
+    return (bytes + 15) / 16 - 1;
+}
+
+/**
+ * @brief Выделение блока с учетом
+ *
+ * @details
+ * Порядок: арена (если включена) -> список свободных блоков потока ->
+ * куча. Кэшируемые блоки берутся из кучи с размером, округленным до
+ * класса, чтобы блок подходил любому запросу того же класса.
+ */
+void* NodeMemory::allocate(std::size_t bytes) {
+    FreeCache& cache = threadCache;
+    void* pointer = HugePageArena::allocate(bytes);
+    if (!pointer) {
+        std::size_t index = cacheIndex(bytes);
+        if (index < CACHE_CLASSES) {
+            pointer = cache.pop(index);
+            if (pointer) {
+                threadStats.recycled++;
+            }
+            else {
+                pointer = ::operator new((index + 1) * 16);
+                threadStats.systemAllocations++;
+            }
+        }
+        else {
+            pointer = ::operator new(bytes);
+            threadStats.systemAllocations++;
+        }
+    }
+    threadStats.liveBytes += bytes;
+    threadStats.allocations++;
+    if (threadStats.liveBytes > threadStats.peakBytes) threadStats.peakBytes = threadStats.liveBytes;
+    cache.tick();
+    return pointer;
+}
+
+void NodeMemory::deallocate(void* pointer, std::size_t bytes) noexcept {
+    if (!pointer) return;
+    threadStats.liveBytes -= bytes;
+    threadStats.deallocations++;
+    if (HugePageArena::deallocate(pointer, bytes)) return;
+
+    FreeCache& cache = threadCache;
+    std::size_t index = cacheIndex(bytes);
+    if (index >= CACHE_CLASSES || !cache.push(index, pointer)) ::operator delete(pointer);
+    cache.tick();
+}
+
+void NodeMemory::setCacheLimit(int blocksPerClass) {
+    cacheLimit.store(blocksPerClass < 0 ? 0 : blocksPerClass, std::memory_order_relaxed);
+}
+
+void NodeMemory::trim() {
+    for (std::size_t index = 0; index < CACHE_CLASSES; index++) threadCache.release(index, 0);
+}
+
+long long NodeMemory::cachedBytes() {
+    return threadCache.cachedBytes();
+}
+
+MemoryStats NodeMemory::current() {
+    return threadStats;
+}
+
+MemoryStats NodeMemory::mark() {
+    threadStats.peakBytes = threadStats.liveBytes;
+    return threadStats;
+}
+
+MemoryStats NodeMemory::since(const MemoryStats& start) {
+    MemoryStats delta;
+    delta.liveBytes = threadStats.liveBytes - start.liveBytes;
+    delta.peakBytes = threadStats.peakBytes - start.liveBytes;
+    delta.allocations = threadStats.allocations - start.allocations;
+    delta.deallocations = threadStats.deallocations - start.deallocations;
+    delta.systemAllocations = threadStats.systemAllocations - start.systemAllocations;
+    delta.recycled = threadStats.recycled - start.recycled;
+    return delta;
+}
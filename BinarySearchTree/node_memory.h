@@ -0,0 +1,136 @@
+﻿#ifndef NODE_MEMORY_H
+#define NODE_MEMORY_H
+
+#include <cstddef>
+
+/**
+ * @file node_memory.h
+ * @brief Учет памяти, занятой узлами деревьев
+ *
+ * Все узлы TreeNode и DBNode, а также массивы ключей и потомков DBNode
+ * выделяются через NodeMemory: TreeNode и DBNode объявляют собственные
+ * operator new/delete, а векторы DBNode используют NodeAllocator. Поэтому
+ * учет видит и служебные поля узлов, и запас емкости векторов DBNode,
+ * которые не видны по числу ключей.
+ *
+ * Блоки берутся из кучи, а после HugePageArena::enable() - из арены
+ * на больших страницах (кроме крупных массивов). Освобожденные блоки кучи
+ * до 256 байт не возвращаются в кучу сразу, а попадают в ограниченные
+ * списки свободных блоков потока и достаются следующим вставкам: при
+ * устойчивой смеси вставок и удалений обращений к куче нет.
+ *
+ * Счетчики у каждого потока свои, как у OpStats: построение дерева в потоке
+ * видит только свои выделения. Узел, освобожденный не тем потоком, который
+ * его выделил, уменьшает счетчики освобождающего потока.
+ */
+
+/**
+ * @brief Счетчики выделений памяти узлов
+ */
+struct MemoryStats {
+    long long liveBytes = 0;       // Занято сейчас
+    long long peakBytes = 0;       // Максимум liveBytes
+    long long allocations = 0;     // Выделений
+    long long deallocations = 0;   // Освобождений
+    long long systemAllocations = 0;  // Выделений из кучи (::operator new)
+    long long recycled = 0;        // Выделений из списков свободных блоков
+
+    /**
+     * @brief Занятая память на один ключ
+     * @param keys Количество ключей в дереве
+     * @return liveBytes / keys (0 для пустого дерева)
+     */
+    double bytesPerKey(long long keys) const {
+        return keys > 0 ? static_cast<double>(liveBytes) / keys : 0.0;
+    }
+};
+
+class NodeMemory {
+public:
+    /// Предел длины списка свободных блоков одного класса по умолчанию
+    static const int DEFAULT_CACHE_LIMIT = 4096;
+
+    /**
+     * @brief Выделение блока с учетом
+     * @param bytes Размер блока
+     * @return Указатель на блок (std::bad_alloc при нехватке памяти)
+     */
+    static void* allocate(std::size_t bytes);
+
+    /**
+     * @brief Освобождение блока с учетом
+     * @param pointer Указатель на блок (nullptr допустим)
+     * @param bytes Размер блока, переданный в allocate
+     */
+    static void deallocate(void* pointer, std::size_t bytes) noexcept;
+
+    /**
+     * @brief Счетчики текущего потока с начала его работы
+     */
+    static MemoryStats current();
+
+    /**
+     * @brief Предел длины списка свободных блоков одного класса размера
+     * @param blocksPerClass Блоков на класс в каждом потоке (0 - без кэширования)
+     */
+    static void setCacheLimit(int blocksPerClass);
+
+    /**
+     * @brief Возврат в кучу всех кэшированных блоков текущего потока
+     *
+     * @note Кэш и сам подрезается: раз в 65536 операций возвращается
+     *       половина блоков, пролежавших без дела весь период.
+     */
+    static void trim();
+
+    /**
+     * @brief Байт в списках свободных блоков текущего потока
+     */
+    static long long cachedBytes();
+
+    /**
+     * @brief Начало замера: пик сбрасывается до текущего liveBytes
+     * @return Отметка для since()
+     */
+    static MemoryStats mark();
+
+    /**
+     * @brief Расход памяти с момента отметки
+     * @param start Отметка, полученная от mark()
+     * @return Приращения счетчиков; peakBytes - пик сверх start.liveBytes
+     *
+     * @note Типичное использование: mark() перед построением дерева,
+     *       since() после него - это память, занятая деревом.
+     */
+    static MemoryStats since(const MemoryStats& start);
+};
+
+/**
+ * @brief Аллокатор STL-контейнеров поверх NodeMemory
+ * @tparam T Тип элементов
+ */
+template <typename T>
+struct NodeAllocator {
+    typedef T value_type;
+
+    NodeAllocator() {}
+
+    template <typename U>
+    NodeAllocator(const NodeAllocator<U>&) {}
+
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(NodeMemory::allocate(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, std::size_t count) noexcept {
+        NodeMemory::deallocate(pointer, count * sizeof(T));
+    }
+
+    template <typename U>
+    bool operator==(const NodeAllocator<U>&) const { return true; }
+
+    template <typename U>
+    bool operator!=(const NodeAllocator<U>&) const { return false; }
+};
+
+#endif // NODE_MEMORY_H
@@ -0,0 +1,98 @@
+﻿#ifndef OP_STATS_H
+#define OP_STATS_H
+
+/**
+ * @file op_stats.h
+ * @brief Счетчики операций на горячих путях вставки и поиска
+ *
+ * Время работы не показывает, за счет чего дерево быстрее или медленнее,
+ * поэтому вставки, повороты, разделения и поиск считают элементарные операции:
+ *  - comparisons - сравнения искомого ключа с ключами узлов (трехпутевое
+ *    сравнение в СДП/АВЛ считается одним, в ДБД считается каждое сравнение
+ *    внутри узла)
+ *  - rotations - повороты АВЛ (двойной поворот дает 2)
+ *  - splits - разделения узлов ДБД
+ *  - nodeVisits - узлы, пройденные при спуске
+ *
+ * Счетчики включаются макросом COLLECT_OP_STATS (как DEBUG_MEMORY в
+ * memory_utils.cpp). Без него OP_STATS_ADD раскрывается в пустое выражение
+ * и горячие пути компилируются без изменений. Счетчики у каждого потока свои,
+ * поэтому параллельные построения не мешают друг другу и не требуют атомиков.
+ */
+struct OpStats {
+    long long comparisons = 0;  // Сравнения ключей
+    long long rotations = 0;    // Повороты АВЛ
+    long long splits = 0;       // Разделения узлов ДБД
+    long long nodeVisits = 0;   // Пройденные узлы
+
+    /**
+     * @brief Счетчики текущего потока
+     * @return Ссылка на thread_local экземпляр
+     */
+    static OpStats& current() {
+        thread_local OpStats stats;
+        return stats;
+    }
+
+    /**
+     * @brief Снимок счетчиков текущего потока с обнулением
+     * @return Значения, накопленные с предыдущего вызова collect() или reset()
+     *
+     * @note Типичное использование: reset() перед построением,
+     *       collect() после него.
+     */
+    static OpStats collect() {
+        OpStats snapshot = current();
+        current().reset();
+        return snapshot;
+    }
+
+    /**
+     * @brief Собраны ли счетчики в этой сборке
+     * @return true если определен COLLECT_OP_STATS
+     */
+    static constexpr bool enabled() {
+#ifdef COLLECT_OP_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Сравнение "меньше" с учетом в счетчике comparisons
+     * @param a Левый операнд
+     * @param b Правый операнд
+     * @return a < b
+     */
+    static bool less(int a, int b);
+
+    /**
+     * @brief Обнуление счетчиков
+     */
+    void reset() {
+        *this = OpStats();
+    }
+};
+
+/**
+ * @brief Компаратор для std::lower_bound/std::binary_search, считающий сравнения
+ */
+struct CountingLess {
+    bool operator()(int a, int b) const {
+        return OpStats::less(a, b);
+    }
+};
+
+#ifdef COLLECT_OP_STATS
+#define OP_STATS_ADD(field, n) (OpStats::current().field += (n))
+#else
+#define OP_STATS_ADD(field, n) ((void)0)
+#endif
+
+inline bool OpStats::less(int a, int b) {
+    OP_STATS_ADD(comparisons, 1);
+    return a < b;
+}
+
+#endif // OP_STATS_H
@@ -0,0 +1,107 @@
+﻿/**
+ * @file output_sink.cpp
+ * @brief Реализация буферизованного вывода отчетов
+ */
+
+#include "output_sink.h"
+#include <cstring>
+#include <iostream>
+
+OutputBuffer::OutputBuffer(std::FILE* file, size_t bufferSize)
+    : file(file), storage(bufferSize > 0 ? bufferSize : 1) {
+    setp(storage.data(), storage.data() + storage.size());
+}
+
+OutputBuffer::~OutputBuffer() {
+    drain();
+}
+
+bool OutputBuffer::drain() {
+    size_t pending = static_cast<size_t>(pptr() - pbase());
+    setp(storage.data(), storage.data() + storage.size());
+    if (pending == 0 || !file) return true;
+    unflushed = true;
+    return std::fwrite(storage.data(), 1, pending, file) == pending;
+}
+
+OutputBuffer::int_type OutputBuffer::overflow(int_type ch) {
+    if (!drain()) return traits_type::eof();
+    if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(ch);
+        pbump(1);
+    }
+    return traits_type::not_eof(ch);
+}
+
+/**
+ * @brief Запись блока данных
+ *
+ * @details
+ * Блок, который помещается в свободное место, копируется в буфер.
+ * Иначе буфер сбрасывается, и блок либо копируется в опустевший буфер,
+ * либо (если он не меньше буфера) пишется в файл напрямую.
+ */
+std::streamsize OutputBuffer::xsputn(const char* data, std::streamsize count) {
+    size_t size = static_cast<size_t>(count);
+    if (size > static_cast<size_t>(epptr() - pptr())) {
+        if (!drain()) return 0;
+        if (size >= storage.size()) {
+            unflushed = file != nullptr;
+            return file ? static_cast<std::streamsize>(std::fwrite(data, 1, size, file)) : count;
+        }
+    }
+    std::memcpy(pptr(), data, size);
+    pbump(static_cast<int>(size));
+    return count;
+}
+
+/**
+ * @brief Сброс буфера и файла
+ *
+ * @details
+ * fflush вызывается, только если с прошлого сброса что-то было записано:
+ * пустой сброс (например, из-за привязки к std::cout) не стоит системного
+ * вызова.
+ */
+int OutputBuffer::sync() {
+    if (!drain()) return -1;
+    if (!unflushed) return 0;
+    unflushed = false;
+    return std::fflush(file) != 0 ? -1 : 0;
+}
+
+// Текущий поток отчетов (nullptr - консоль)
+static OutputSink* reportSink = nullptr;
+
+OutputSink::OutputSink(const std::string& path, size_t bufferSize)
+    : OutputSink(std::fopen(path.c_str(), "wb"), true, bufferSize) {
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось открыть файл отчета " << path << std::endl;
+        setstate(std::ios::badbit);
+    }
+}
+
+OutputSink::OutputSink(std::FILE* file, bool ownsFile, size_t bufferSize)
+    : std::ostream(nullptr), file(file), ownsFile(ownsFile), buffer(file, bufferSize) {
+    rdbuf(&buffer);
+}
+
+OutputSink::~OutputSink() {
+    if (reportSink == this) reportSink = nullptr;
+    buffer.pubsync();
+    if (ownsFile && file) std::fclose(file);
+}
+
+OutputSink& OutputSink::console() {
+    static OutputSink sink(stdout, false, DEFAULT_BUFFER_SIZE);
+    return sink;
+}
+
+OutputSink& OutputSink::report() {
+    return reportSink ? *reportSink : console();
+}
+
+void OutputSink::setReport(OutputSink* sink) {
+    report().flush();
+    reportSink = sink;
+}
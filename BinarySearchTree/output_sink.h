@@ -0,0 +1,101 @@
+﻿#ifndef OUTPUT_SINK_H
+#define OUTPUT_SINK_H
+
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+/**
+ * @file output_sink.h
+ * @brief Буферизованный вывод отчетов (таблиц и деревьев)
+ *
+ * std::endl на каждой строке сбрасывает std::cout, и при выводе больших
+ * деревьев и длинных таблиц время уходит на системные вызовы записи.
+ * OutputSink - это std::ostream (работают std::setw, std::fixed и т.д.)
+ * с большим буфером: данные пишутся в stdout или файл, только когда буфер
+ * заполнен или при явном flush().
+ *
+ * OutputUtils и лабораторные работы пишут в OutputSink::report(). Перед
+ * чтением std::cin отчет сбрасывается явно, а main() привязывает
+ * console() к std::cout (std::cout.tie), чтобы строки тестов и отчетов
+ * не перемешались.
+ */
+
+/**
+ * @brief Буфер потока поверх FILE*
+ */
+class OutputBuffer : public std::streambuf {
+public:
+    /**
+     * @param file Файл для записи (не закрывается буфером)
+     * @param bufferSize Размер буфера в байтах
+     */
+    OutputBuffer(std::FILE* file, size_t bufferSize);
+    ~OutputBuffer() override;
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(const char* data, std::streamsize count) override;
+    int sync() override;
+
+private:
+    std::FILE* file;
+    std::vector<char> storage;
+    bool unflushed = false;  // В file записаны данные без fflush
+
+    /// Запись накопленных данных в файл
+    bool drain();
+};
+
+class OutputSink : public std::ostream {
+public:
+    /// Размер буфера по умолчанию
+    static const size_t DEFAULT_BUFFER_SIZE = 1 << 20;
+
+    /**
+     * @brief Вывод в файл
+     * @param path Путь к файлу (перезаписывается)
+     * @param bufferSize Размер буфера
+     *
+     * @note Если файл не открылся, поток переходит в состояние ошибки
+     *       (isOpen() == false), вывод отбрасывается.
+     */
+    explicit OutputSink(const std::string& path, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /// Сбрасывает буфер и закрывает файл
+    ~OutputSink() override;
+
+    /// Файл открыт (для консоли всегда true)
+    bool isOpen() const { return file != nullptr; }
+
+    /**
+     * @brief Поток в stdout с буфером DEFAULT_BUFFER_SIZE
+     */
+    static OutputSink& console();
+
+    /**
+     * @brief Текущий поток отчетов (по умолчанию console())
+     */
+    static OutputSink& report();
+
+    /**
+     * @brief Смена потока отчетов
+     * @param sink Новый поток (nullptr - вернуть console()); прежний сбрасывается
+     *
+     * @note Поток должен жить, пока он установлен потоком отчетов.
+     */
+    static void setReport(OutputSink* sink);
+
+private:
+    /// Вывод в уже открытый файл (используется console())
+    OutputSink(std::FILE* file, bool ownsFile, size_t bufferSize);
+
+    std::FILE* file;
+    bool ownsFile;
+    OutputBuffer buffer;
+};
+
+#endif // OUTPUT_SINK_H
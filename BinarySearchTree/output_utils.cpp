@@ -1,8 +1,13 @@
 #include "output_utils.h"
+#include "output_sink.h"
 #include "tree_properties.h"
+#include "tree_traversal.h"
 #include "theory_calculations.h"
+#include "op_stats.h"
+#include "node_memory.h"
 #include <iostream>
 #include <iomanip>
+#include <vector>
 
 /**
  * @file output_utils.cpp
@@ -15,47 +20,51 @@
   *       .
   * : ( - -)
   *    .
+  *
+  *     :     ,  ,
+  *     ,   
+  *    .
   */
 void OutputUtils::printTreeBracket(TreeNode* root) {
+    std::ostream& out = OutputSink::report();
     if (root == nullptr) {
-        std::cout << "()";
+        out << "()";
         return;
     }
 
-    std::cout << "(";
-    printTreeBracketRecursive(root);
-    std::cout << ")";
-    std::cout << std::endl;
-}
-
-/**
- * @brief      
- *
- *       .
- *            .
- */
-void OutputUtils::printTreeBracketRecursive(TreeNode* node) {
-    if (node == nullptr) {
-        return;
-    }
+    struct Item {
+        TreeNode* node;    //     nullptr
+        const char* text;  // ,  node == nullptr
+    };
+
+    out << "(";
+    std::vector<Item> stack = { { root, nullptr } };
+    while (!stack.empty()) {
+        Item item = stack.back();
+        stack.pop_back();
+        if (item.node == nullptr) {
+            out << item.text;
+            continue;
+        }
 
-    std::cout << node->key;
+        TreeNode* node = item.node;
+        out << node->key;
 
-    //   ,    
-    if (node->left != nullptr || node->right != nullptr) {
-        std::cout << " (";
-        if (node->left != nullptr) {
-            printTreeBracketRecursive(node->left);
+        //     : " ("  ")" " ("  ")"
+        if (node->right != nullptr) {
+            stack.push_back({ nullptr, ")" });
+            stack.push_back({ node->right, nullptr });
+            stack.push_back({ nullptr, " (" });
+        }
+        //    (, ),      
+        if (node->left != nullptr || node->right != nullptr) {
+            stack.push_back({ nullptr, ")" });
+            if (node->left != nullptr) stack.push_back({ node->left, nullptr });
+            stack.push_back({ nullptr, " (" });
         }
-        std::cout << ")";
-    }
-
-    //   ,    
-    if (node->right != nullptr) {
-        std::cout << " (";
-        printTreeBracketRecursive(node->right);
-        std::cout << ")";
     }
+    out << ")";
+    out << '\n';
 }
 
 /**
@@ -63,25 +72,28 @@ void OutputUtils::printTreeBracketRecursive(TreeNode* node) {
  *
  *   ,   in-order .
  *  BST     .
+ *    ,    20 .
  */
 void OutputUtils::printInOrder(TreeNode* root, const std::string& title) {
-    std::vector<int> traversal = TreeProperties::inOrderTraversal(root);
+    std::ostream& out = OutputSink::report();
+    int size = TreeProperties::calculateSize(root);
 
-    std::cout << title << std::endl;
-    std::cout << " : " << traversal.size() << std::endl;
-    std::cout << ": ";
+    out << title << '\n';
+    out << " : " << size << '\n';
+    out << ": ";
 
     //   20   
     int count = 0;
-    for (int key : traversal) {
-        std::cout << key << " ";
+    TreeTraversal::visitInOrder(root, [&](int key) {
+        out << key << " ";
         count++;
-        if (count >= 20 && traversal.size() > 20) {
-            std::cout << "... ( " << traversal.size() << " )";
-            break;
+        if (count >= 20 && size > 20) {
+            out << "... ( " << size << " )";
+            return false;
         }
-    }
-    std::cout << std::endl << std::endl;
+        return true;
+    });
+    out << '\n' << '\n';
 }
 
 /**
@@ -93,40 +105,41 @@ void OutputUtils::printInOrder(TreeNode* root, const std::string& title) {
  * -  5 
  */
 void OutputUtils::printInOrderSampled(TreeNode* root, const std::string& title) {
-    std::vector<int> traversal = TreeProperties::inOrderTraversal(root);
+    std::ostream& out = OutputSink::report();
+    TraversalSample sample = TreeTraversal::sampleInOrder(root);
 
-    std::cout << title << std::endl;
-    std::cout << " : " << traversal.size() << std::endl;
-    std::cout << ": ";
-
-    if (traversal.size() <= 15) {
-        //    -  
-        for (int key : traversal) {
-            std::cout << key << " ";
-        }
+    out << title << '\n';
+    if (sample.complete) {
+        out << " : " << sample.first.size() << '\n';
     }
     else {
-        //  5 
-        for (int i = 0; i < 5; i++) {
-            std::cout << traversal[i] << " ";
-        }
-        std::cout << "... ";
-
-        // 5   ,  
-        int step = traversal.size() / 6; //   6 ,    
-        for (int i = 1; i <= 5; i++) {
-            int index = i * step;
-            std::cout << traversal[index] << " ";
-            if (i < 5) std::cout << "... ";
-        }
-        std::cout << "... ";
+        out << " : " << sample.first.front() << " .. " << sample.last.back() << '\n';
+    }
+    out << ": ";
+    printTraversalSample(sample);
+    out << '\n';
+}
 
-        //  5 
-        for (int i = traversal.size() - 5; i < traversal.size(); i++) {
-            std::cout << traversal[i] << " ";
+/**
+ * @brief    
+ *
+ *    ,    ,
+ *      .
+ */
+void OutputUtils::printTraversalSample(const TraversalSample& sample) {
+    std::ostream& out = OutputSink::report();
+    for (int key : sample.first) out << key << " ";
+
+    if (!sample.complete) {
+        out << "... ";
+        for (size_t i = 0; i < sample.middle.size(); i++) {
+            out << sample.middle[i] << " ";
+            if (i + 1 < sample.middle.size()) out << "... ";
         }
+        out << "... ";
+        for (int key : sample.last) out << key << " ";
     }
-    std::cout << std::endl << std::endl;
+    out << '\n';
 }
 
 /**
@@ -136,37 +149,39 @@ void OutputUtils::printInOrderSampled(TreeNode* root, const std::string& title)
  *       .
  */
 void OutputUtils::printTreeProperties(TreeNode* root, const std::string& treeName) {
-    std::cout << "=== " << treeName << " ===" << std::endl;
+    std::ostream& out = OutputSink::report();
+    out << "=== " << treeName << " ===\n";
 
     if (root == nullptr) {
-        std::cout << " " << std::endl << std::endl;
+        out << " \n\n";
         return;
     }
 
-    int size = TreeProperties::calculateSize(root);
-    int height = TreeProperties::calculateHeight(root);
-    int checkSum = TreeProperties::calculateCheckSum(root);
-    double avgHeight = TreeProperties::calculateAverageHeight(root);
+    TreeStats stats = TreeProperties::calculateStats(root);
+    int size = stats.size;
+    int height = stats.height;
+    long long checkSum = stats.checkSum;
+    double avgHeight = stats.averageLeafDepth;
 
-    std::cout << " : " << size << std::endl;
-    std::cout << " : " << height << std::endl;
-    std::cout << " : " << checkSum << std::endl;
-    std::cout << " : " << std::fixed << std::setprecision(2) << avgHeight << std::endl;
+    out << " : " << size << '\n';
+    out << " : " << height << '\n';
+    out << " : " << checkSum << '\n';
+    out << " : " << std::fixed << std::setprecision(2) << avgHeight << '\n';
 
     //    
     if (treeName.find("") != std::string::npos || treeName.find("") != std::string::npos) {
         //       
         double theoreticalHeightIB = TheoryCalculations::theoreticalHeightBalanced(size);
         double theoreticalAvgHeightIB = TheoryCalculations::theoreticalAverageHeightBalanced(size);
-        std::cout << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightIB << std::endl;
-        std::cout << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightIB << std::endl;
+        out << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightIB << '\n';
+        out << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightIB << '\n';
     }
     else if (treeName.find("") != std::string::npos || treeName.find("") != std::string::npos) {
         //       
         double theoreticalHeightSP = TheoryCalculations::theoreticalHeightRandomBST(size);
         double theoreticalAvgHeightSP = TheoryCalculations::theoreticalAverageHeightRandomBST(size);
-        std::cout << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightSP << std::endl;
-        std::cout << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightSP << std::endl;
+        out << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightSP << '\n';
+        out << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightSP << '\n';
     }
     else {
         //    -  
@@ -174,13 +189,13 @@ void OutputUtils::printTreeProperties(TreeNode* root, const std::string& treeNam
         double theoreticalAvgHeightIB = TheoryCalculations::theoreticalAverageHeightBalanced(size);
         double theoreticalHeightSP = TheoryCalculations::theoreticalHeightRandomBST(size);
         double theoreticalAvgHeightSP = TheoryCalculations::theoreticalAverageHeightRandomBST(size);
-        std::cout << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightIB << std::endl;
-        std::cout << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightIB << std::endl;
-        std::cout << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightSP << std::endl;
-        std::cout << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightSP << std::endl;
+        out << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightIB << '\n';
+        out << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightIB << '\n';
+        out << ".  : " << std::fixed << std::setprecision(2) << theoreticalHeightSP << '\n';
+        out << ". .  : " << std::fixed << std::setprecision(2) << theoreticalAvgHeightSP << '\n';
     }
 
-    std::cout << std::endl;
+    out << '\n';
 }
 
 /**
@@ -193,38 +208,43 @@ void OutputUtils::printTableHeader(
     const std::string& leftGroup,
     const std::string& rightGroup)
 {
+    std::ostream& out = OutputSink::report();
 
     // ====  ====
-    std::cout << std::setw(9) << "" << std::setw(6) << " | ";
+    out << std::setw(9) << "" << std::setw(6) << " | ";
 
-    std::cout << std::setw(22) << leftGroup
-        << std::setw(21) << " | "
-        << std::setw(22) << rightGroup
-        << std::setw(21) << std::endl;
+    out << std::setw(28) << leftGroup
+        << std::setw(26) << " | "
+        << std::setw(28) << rightGroup
+        << '\n';
 
     // ====  1 ====
-    std::cout << std::setw(12) << " " << " | ";
+    out << std::setw(12) << " " << " | ";
 
-    std::cout << std::setw(10) << "."
+    out << std::setw(10) << "."
         << std::setw(12) << ""
-        << std::setw(18) << "." << " | ";
+        << std::setw(18) << "."
+        << std::setw(12) << "" << " | ";
 
-    std::cout << std::setw(10) << "."
+    out << std::setw(10) << "."
         << std::setw(12) << ""
-        << std::setw(18) << "." << std::endl;
+        << std::setw(18) << "."
+        << std::setw(12) << "\n";
 
     // ====  2 ====
-    std::cout << std::setw(12) << " " << " | ";
+    out << std::setw(12) << " " << " | ";
 
-    std::cout << std::setw(10) << ""
+    out << std::setw(10) << ""
         << std::setw(12) << "."
-        << std::setw(18) << ". " << " | ";
+        << std::setw(18) << ". "
+        << std::setw(12) << " " << " | ";
 
-    std::cout << std::setw(10) << ""
+    out << std::setw(10) << ""
         << std::setw(12) << "."
-        << std::setw(18) << ". " << std::endl;
+        << std::setw(18) << ". "
+        << std::setw(12) << " \n";
 
-    std::cout << std::string(100, '-') << std::endl;
+    out << std::string(124, '-') << '\n';
 }
 
 
@@ -235,19 +255,22 @@ void OutputUtils::printTableHeader(
  *       .
  */
 void OutputUtils::printTableRow(int size,
-    int checkSumSP, double heightSP, double theoreticalAvgHeightSP,
-    int checkSumIB, double heightIB, double theoreticalAvgHeightIB) {
-    std::cout << std::setw(12) << size << " | ";
+    long long checkSumSP, double heightSP, double theoreticalAvgHeightSP, double bytesPerKeySP,
+    long long checkSumIB, double heightIB, double theoreticalAvgHeightIB, double bytesPerKeyIB) {
+    std::ostream& out = OutputSink::report();
+    out << std::setw(12) << size << " | ";
 
     //   
-    std::cout << std::setw(10) << checkSumSP << " "
+    out << std::setw(10) << checkSumSP << " "
         << std::setw(12) << std::fixed << std::setprecision(1) << heightSP << " "
-        << std::setw(16) << std::fixed << std::setprecision(2) << theoreticalAvgHeightSP << " | ";
+        << std::setw(16) << std::fixed << std::setprecision(2) << theoreticalAvgHeightSP << " "
+        << std::setw(11) << std::fixed << std::setprecision(1) << bytesPerKeySP << " | ";
 
     //   
-    std::cout << std::setw(10) << checkSumIB << " "
+    out << std::setw(10) << checkSumIB << " "
         << std::setw(12) << std::fixed << std::setprecision(1) << heightIB << " "
-        << std::setw(16) << std::fixed << std::setprecision(2) << theoreticalAvgHeightIB << std::endl;
+        << std::setw(16) << std::fixed << std::setprecision(2) << theoreticalAvgHeightIB << " "
+        << std::setw(11) << std::fixed << std::setprecision(1) << bytesPerKeyIB << '\n';
 }
 
 /**
@@ -257,16 +280,17 @@ void OutputUtils::printTableRow(int size,
  *      .
  */
 void OutputUtils::printTheoreticalEstimates(const std::vector<int>& sizes) {
-    std::cout << std::endl << std::string(80, '=') << std::endl;
-    std::cout << " " << std::endl;
-    std::cout << std::string(80, '=') << std::endl;
-
-    std::cout << std::setw(8) << "" << " | ";
-    std::cout << std::setw(12) << " " << " | ";
-    std::cout << std::setw(15) << " ." << " | ";
-    std::cout << std::setw(12) << " " << " | ";
-    std::cout << std::setw(15) << " ." << std::endl;
-    std::cout << std::string(80, '-') << std::endl;
+    std::ostream& out = OutputSink::report();
+    out << '\n' << std::string(80, '=') << '\n';
+    out << " \n";
+    out << std::string(80, '=') << '\n';
+
+    out << std::setw(8) << "" << " | ";
+    out << std::setw(12) << " " << " | ";
+    out << std::setw(15) << " ." << " | ";
+    out << std::setw(12) << " " << " | ";
+    out << std::setw(15) << " .\n";
+    out << std::string(80, '-') << '\n';
 
     for (int size : sizes) {
         double thHeightIB = TheoryCalculations::theoreticalHeightBalanced(size);
@@ -274,14 +298,14 @@ void OutputUtils::printTheoreticalEstimates(const std::vector<int>& sizes) {
         double thHeightSP = TheoryCalculations::theoreticalHeightRandomBST(size);
         double thAvgHeightSP = TheoryCalculations::theoreticalAverageHeightRandomBST(size);
 
-        std::cout << std::setw(8) << size << " | ";
-        std::cout << std::setw(12) << std::fixed << std::setprecision(2) << thHeightIB << " | ";
-        std::cout << std::setw(15) << std::fixed << std::setprecision(2) << thAvgHeightIB << " | ";
-        std::cout << std::setw(12) << std::fixed << std::setprecision(2) << thHeightSP << " | ";
-        std::cout << std::setw(15) << std::fixed << std::setprecision(2) << thAvgHeightSP << std::endl;
+        out << std::setw(8) << size << " | ";
+        out << std::setw(12) << std::fixed << std::setprecision(2) << thHeightIB << " | ";
+        out << std::setw(15) << std::fixed << std::setprecision(2) << thAvgHeightIB << " | ";
+        out << std::setw(12) << std::fixed << std::setprecision(2) << thHeightSP << " | ";
+        out << std::setw(15) << std::fixed << std::setprecision(2) << thAvgHeightSP << '\n';
     }
 
-    std::cout << std::string(80, '=') << std::endl << std::endl;
+    out << std::string(80, '=') << '\n' << '\n';
 }
 
 
@@ -298,35 +322,40 @@ void OutputUtils::printTheoreticalEstimates(const std::vector<int>& sizes) {
  * 3.  
  */
 void OutputUtils::printDBTableHeader() {
-    std::cout
+    std::ostream& out = OutputSink::report();
+    out
         << std::setw(6) << "" << " | "
         << std::setw(32) << "              " << " | "
         << std::setw(30) << ""
-        << std::endl;
+        << '\n';
 
-    std::cout << std::right
+    out << std::right
         << std::setw(6) << "" << " | "
         << std::setw(12) << "."
         << std::setw(8) << "."
-        << std::setw(12) << ". ." << " | "
+        << std::setw(12) << ". ."
+        << std::setw(10) << "" << " | "
         << std::setw(15) << "."
         << std::setw(10) << ""
         << std::setw(9) << "."
         << std::setw(12) << ". "
-        << std::endl;
+        << std::setw(10) << ""
+        << '\n';
 
-    std::cout << std::right
+    out << std::right
         << std::setw(6) << "" << " | "
         << std::setw(12) << "."
         << std::setw(8) << ""
-        << std::setw(12) << "" << " | "
+        << std::setw(12) << ""
+        << std::setw(10) << " " << " | "
         << std::setw(15) << "."
         << std::setw(10) << ""
         << std::setw(9) << ""
         << std::setw(12) << ""
-        << std::endl;
+        << std::setw(10) << " "
+        << '\n';
 
-    std::cout << std::string(90, '-') << std::endl;
+    out << std::string(110, '-') << '\n';
 }
 
 /**
@@ -336,10 +365,12 @@ void OutputUtils::printDBTableHeader() {
  * @param avlCheckSum   -
  * @param avlHeight   -
  * @param avlAvg    -
+ * @param avlBytesPerKey   -  
  * @param dbCheckSum   B-
  * @param dbLevels    B-
  * @param dbHeightTheo   B-
  * @param dbAvgTheo    B-
+ * @param dbBytesPerKey     
  *
  * @details
  *           .
@@ -347,17 +378,80 @@ void OutputUtils::printDBTableHeader() {
  *       .
  */
 void OutputUtils::printDBTableRow(int size,
-    int avlCheckSum, int avlHeight, double avlAvg,
-    int dbCheckSum, int dbLevels, double dbHeightTheo, double dbAvgTheo) {
-    std::cout << std::right
+    long long avlCheckSum, int avlHeight, double avlAvg, double avlBytesPerKey,
+    long long dbCheckSum, int dbLevels, double dbHeightTheo, double dbAvgTheo, double dbBytesPerKey) {
+    std::ostream& out = OutputSink::report();
+    out << std::right
         << std::setw(6) << size << " | "
         << std::setw(12) << avlCheckSum
         << std::setw(8) << avlHeight
-        << std::setw(12) << std::fixed << std::setprecision(2) << avlAvg << " | "
+        << std::setw(12) << std::fixed << std::setprecision(2) << avlAvg
+        << std::setw(10) << std::setprecision(1) << avlBytesPerKey << " | "
         << std::setw(15) << dbCheckSum
         << std::setw(10) << dbLevels
-        << std::setw(9) << dbHeightTheo
+        << std::setw(9) << std::setprecision(2) << dbHeightTheo
         << std::setw(12) << dbAvgTheo
-        << std::endl;
+        << std::setw(10) << std::setprecision(1) << dbBytesPerKey
+        << '\n';
 }
 
+/**
+ * @brief     
+ * @param group  
+ * @param stats 
+ */
+static void printOpStats(const std::string& group, const OpStats& stats) {
+    std::ostream& out = OutputSink::report();
+    out << group << ": . " << stats.comparisons
+        << ", . " << stats.rotations
+        << ", . " << stats.splits
+        << ",  " << stats.nodeVisits;
+}
+
+/**
+ * @brief       
+ *
+ *      ,   
+ *        .
+ */
+void OutputUtils::printOpStatsRow(
+    const std::string& leftGroup, const OpStats& left,
+    const std::string& rightGroup, const OpStats& right) {
+    std::ostream& out = OutputSink::report();
+    if (!OpStats::enabled()) return;
+
+    out << std::setw(12) << " " << " | ";
+    printOpStats(leftGroup, left);
+    out << " | ";
+    printOpStats(rightGroup, right);
+    out << '\n';
+}
+
+/**
+ * @brief     
+ * @param group  
+ * @param stats    
+ */
+static void printMemoryStats(const std::string& group, const MemoryStats& stats) {
+    std::ostream& out = OutputSink::report();
+    out << group << ": " << std::fixed << std::setprecision(1)
+        << stats.liveBytes / 1024.0 << " ,  " << stats.peakBytes / 1024.0
+        << " ,  " << stats.allocations;
+}
+
+/**
+ * @brief       
+ *
+ *   "  ":     
+ *   ,       .
+ */
+void OutputUtils::printMemoryRow(
+    const std::string& leftGroup, const MemoryStats& left,
+    const std::string& rightGroup, const MemoryStats& right) {
+    std::ostream& out = OutputSink::report();
+    out << std::setw(12) << "" << " | ";
+    printMemoryStats(leftGroup, left);
+    out << " | ";
+    printMemoryStats(rightGroup, right);
+    out << '\n';
+}
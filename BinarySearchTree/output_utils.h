@@ -4,6 +4,9 @@
  *
  *        ,
  *     .
+ *
+ *     OutputSink::report()  std::endl:  
+ *       (. output_sink.h).
  */
 
 #ifndef OUTPUT_UTILS_H
@@ -13,6 +16,10 @@
 #include <vector>
 #include <string>
 
+struct OpStats;
+struct TraversalSample;
+struct MemoryStats;
+
 class OutputUtils {
 public:
     /**
@@ -39,10 +46,20 @@ public:
      * @param title   
      *
      *   5 , 5    (  ...)
-     *   5    .
+     *   5    .    
+     * (TreeTraversal::sampleInOrder),     
+     *     .
      */
     static void printInOrderSampled(TreeNode* root, const std::string& title = "In-order :");
 
+    /**
+     * @brief       
+     * @param sample ,  TreeTraversal::sampleInOrder
+     *
+     * :   ...    ... ...  
+     */
+    static void printTraversalSample(const TraversalSample& sample);
+
     /**
      * @brief   
      * @param root    
@@ -70,13 +87,15 @@ public:
      * @param checkSumSP   
      * @param heightSP  
      * @param theoreticalAvgHeightSP     
+     * @param bytesPerKeySP     
      * @param checkSumIB   
      * @param heightIB  
      * @param theoreticalAvgHeightIB     
+     * @param bytesPerKeyIB     
      */
     static void printTableRow(int size,
-        int checkSumSP, double heightSP, double theoreticalAvgHeightSP,
-        int checkSumIB, double heightIB, double theoreticalAvgHeightIB);
+        long long checkSumSP, double heightSP, double theoreticalAvgHeightSP, double bytesPerKeySP,
+        long long checkSumIB, double heightIB, double theoreticalAvgHeightIB, double bytesPerKeyIB);
 
     /**
      * @brief   
@@ -100,21 +119,42 @@ public:
      * @param avlCheckSum   -
      * @param avlHeight   -
      * @param avlAvg    -
+     * @param avlBytesPerKey   -  
      * @param dbCheckSum   B-
      * @param dbLevels    B-
      * @param dbHeightTheo   B-
      * @param dbAvgTheo    B-
+     * @param dbBytesPerKey     
      */
     static void printDBTableRow(int size,
-        int avlCheckSum, int avlHeight, double avlAvg,
-        int dbCheckSum, int dbLevels, double dbHeightTheo, double dbAvgTheo);
+        long long avlCheckSum, int avlHeight, double avlAvg, double avlBytesPerKey,
+        long long dbCheckSum, int dbLevels, double dbHeightTheo, double dbAvgTheo, double dbBytesPerKey);
 
-private:
     /**
-     * @brief      
-     * @param node  
+     * @brief       
+     * @param leftGroup    
+     * @param left    
+     * @param rightGroup    
+     * @param right    
+     *
+     *   ,     COLLECT_OP_STATS.
+     */
+    static void printOpStatsRow(
+        const std::string& leftGroup, const OpStats& left,
+        const std::string& rightGroup, const OpStats& right);
+
+    /**
+     * @brief       
+     * @param leftGroup    
+     * @param left ,    (NodeMemory::since)
+     * @param rightGroup    
+     * @param right ,   
+     *
+     *        .
      */
-    static void printTreeBracketRecursive(TreeNode* node);
+    static void printMemoryRow(
+        const std::string& leftGroup, const MemoryStats& left,
+        const std::string& rightGroup, const MemoryStats& right);
 };
 
 #endif // OUTPUT_UTILS_H
\ No newline at end of file
@@ -0,0 +1,220 @@
+﻿/**
+ * @file parallel_properties.cpp
+ * @brief Реализация параллельного вычисления характеристик деревьев
+ */
+
+#include "parallel_properties.h"
+#include <algorithm>
+#include <future>
+#include <thread>
+#include <vector>
+
+ /**
+  * @brief Последовательная свертка поддерева
+  * @param root Корень поддерева
+  * @param empty Значение для пустого поддерева
+  * @param combine Функция (узел, результат слева, результат справа) -> результат
+  *
+  * @details
+  * Обход в обратном порядке с явным стеком, как в TreeProperties::calculateStats:
+  * узел сворачивается, когда результаты его поддеревьев уже лежат на стеке
+  * результатов (правый сверху). Глубина дерева ограничена только памятью.
+  */
+template <typename T, typename Combine>
+static T reduceSequential(TreeNode* root, const T& empty, const Combine& combine) {
+    if (root == nullptr) {
+        return empty;
+    }
+
+    std::vector<std::pair<TreeNode*, bool>> stack = { { root, false } };  // (узел, потомки уже в стеке)
+    std::vector<T> results;
+    while (!stack.empty()) {
+        TreeNode* node = stack.back().first;
+        if (!stack.back().second) {
+            stack.back().second = true;
+            if (node->right != nullptr) stack.push_back({ node->right, false });
+            if (node->left != nullptr) stack.push_back({ node->left, false });
+            continue;
+        }
+        stack.pop_back();
+
+        T right = empty;
+        if (node->right != nullptr) {
+            right = results.back();
+            results.pop_back();
+        }
+        T left = empty;
+        if (node->left != nullptr) {
+            left = results.back();
+            results.pop_back();
+        }
+        results.push_back(combine(node, left, right));
+    }
+    return results.back();
+}
+
+/**
+ * @brief Параллельная свертка поддерева
+ * @param node Корень поддерева
+ * @param forkDepth Оставшаяся глубина ветвления
+ * @param empty Значение для пустого поддерева
+ * @param combine Функция свертки
+ *
+ * @details
+ * В узле с двумя потомками левое поддерево отдается отдельной задаче,
+ * правое обрабатывается текущим потоком. Цепочки узлов с одним потомком
+ * (типичные для вырожденных СДП) проходятся циклом без расхода глубины
+ * ветвления, а затем сворачиваются снизу вверх.
+ */
+template <typename T, typename Combine>
+static T reduceParallel(TreeNode* node, int forkDepth, const T& empty, const Combine& combine) {
+    if (forkDepth <= 0) {
+        return reduceSequential(node, empty, combine);
+    }
+
+    // Спуск по цепочке узлов с одним потомком
+    std::vector<TreeNode*> chain;
+    while (node != nullptr && (node->left == nullptr) != (node->right == nullptr)) {
+        chain.push_back(node);
+        node = node->left != nullptr ? node->left : node->right;
+    }
+
+    T result = empty;
+    if (node != nullptr) {
+        if (node->left == nullptr) {
+            result = combine(node, empty, empty);
+        }
+        else {
+            std::future<T> leftTask = std::async(std::launch::async, [&]() {
+                return reduceParallel(node->left, forkDepth - 1, empty, combine);
+            });
+            T right = reduceParallel(node->right, forkDepth - 1, empty, combine);
+            result = combine(node, leftTask.get(), right);
+        }
+    }
+
+    // Свертка цепочки снизу вверх
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        TreeNode* parent = *it;
+        result = parent->left != nullptr
+            ? combine(parent, result, empty)
+            : combine(parent, empty, result);
+    }
+
+    return result;
+}
+
+/**
+ * @brief Глубина ветвления по умолчанию
+ *
+ * На каждом уровне число задач удваивается, поэтому глубина log2(ядер) + 2
+ * дает около 4 задач на ядро.
+ */
+int ParallelProperties::defaultForkDepth() {
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    int depth = 0;
+    while ((1u << depth) < cores) depth++;
+    return depth + 2;
+}
+
+/**
+ * @brief Параллельное вычисление размера дерева
+ *
+ * Формула: size(node) = 1 + size(left) + size(right)
+ */
+int ParallelProperties::calculateSize(TreeNode* root, int forkDepth) {
+    if (forkDepth < 0) forkDepth = defaultForkDepth();
+    return reduceParallel(root, forkDepth, 0, [](TreeNode*, int left, int right) {
+        return 1 + left + right;
+    });
+}
+
+/**
+ * @brief Параллельное вычисление высоты дерева
+ *
+ * Формула: height(node) = 1 + max(height(left), height(right))
+ */
+int ParallelProperties::calculateHeight(TreeNode* root, int forkDepth) {
+    if (forkDepth < 0) forkDepth = defaultForkDepth();
+    return reduceParallel(root, forkDepth, 0, [](TreeNode*, int left, int right) {
+        return 1 + std::max(left, right);
+    });
+}
+
+/**
+ * @brief Параллельное вычисление контрольной суммы
+ *
+ * Формула: sum(node) = key + sum(left) + sum(right)
+ */
+long long ParallelProperties::calculateCheckSum(TreeNode* root, int forkDepth) {
+    if (forkDepth < 0) forkDepth = defaultForkDepth();
+    return reduceParallel(root, forkDepth, 0LL, [](TreeNode* node, long long left, long long right) {
+        return node->key + left + right;
+    });
+}
+
+/**
+ * @brief Количество листьев поддерева и сумма их глубин относительно его корня
+ */
+struct LeafDepths {
+    long long count;
+    long long depthSum;
+};
+
+/**
+ * @brief Параллельное вычисление средней высоты
+ *
+ * Для каждого поддерева считается пара (листья, сумма глубин от корня поддерева).
+ * При подъеме на уровень каждый лист становится на 1 глубже:
+ * depthSum(node) = depthSum(left) + count(left) + depthSum(right) + count(right)
+ */
+double ParallelProperties::calculateAverageHeight(TreeNode* root, int forkDepth) {
+    if (root == nullptr) {
+        return 0.0;
+    }
+
+    if (forkDepth < 0) forkDepth = defaultForkDepth();
+    LeafDepths empty = { 0, 0 };
+    LeafDepths total = reduceParallel(root, forkDepth, empty,
+        [](TreeNode* node, LeafDepths left, LeafDepths right) {
+            if (node->left == nullptr && node->right == nullptr) {
+                return LeafDepths{ 1, 0 };
+            }
+            return LeafDepths{ left.count + right.count,
+                left.depthSum + left.count + right.depthSum + right.count };
+        });
+
+    return static_cast<double>(total.depthSum) / total.count;
+}
+
+/**
+ * @brief Результат проверки поддерева: корректность и диапазон ключей
+ */
+struct BSTRange {
+    bool valid;
+    bool empty;
+    int minKey;
+    int maxKey;
+};
+
+/**
+ * @brief Параллельная проверка свойства дерева поиска
+ *
+ * Проверка выполняется снизу вверх: поддерево корректно, если корректны оба
+ * потомка, максимум левого меньше ключа узла, а минимум правого - больше.
+ */
+bool ParallelProperties::isBinarySearchTree(TreeNode* root, int forkDepth) {
+    if (forkDepth < 0) forkDepth = defaultForkDepth();
+    BSTRange empty = { true, true, 0, 0 };
+    BSTRange result = reduceParallel(root, forkDepth, empty,
+        [](TreeNode* node, BSTRange left, BSTRange right) {
+            bool valid = left.valid && right.valid &&
+                (left.empty || left.maxKey < node->key) &&
+                (right.empty || right.minKey > node->key);
+            return BSTRange{ valid, false,
+                left.empty ? node->key : left.minKey,
+                right.empty ? node->key : right.maxKey };
+        });
+
+    return result.valid;
+}
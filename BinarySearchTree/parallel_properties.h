@@ -0,0 +1,67 @@
+﻿#ifndef PARALLEL_PROPERTIES_H
+#define PARALLEL_PROPERTIES_H
+
+#include "tree_node.h"
+
+/**
+ * @file parallel_properties.h
+ * @brief Параллельное вычисление характеристик больших бинарных деревьев
+ *
+ * Функции повторяют TreeProperties, но обрабатывают левое и правое поддеревья
+ * в разных задачах до заданной глубины ветвления. Ниже этой глубины поддеревья
+ * обрабатываются последовательно.
+ */
+
+class ParallelProperties {
+public:
+    /**
+     * @brief Параллельное вычисление размера дерева
+     * @param root Указатель на корень дерева
+     * @param forkDepth Глубина ветвления задач (-1 - по числу ядер)
+     * @return Количество узлов в дереве
+     */
+    static int calculateSize(TreeNode* root, int forkDepth = -1);
+
+    /**
+     * @brief Параллельное вычисление высоты дерева
+     * @param root Указатель на корень дерева
+     * @param forkDepth Глубина ветвления задач (-1 - по числу ядер)
+     * @return Высота дерева (как TreeProperties::calculateHeight)
+     */
+    static int calculateHeight(TreeNode* root, int forkDepth = -1);
+
+    /**
+     * @brief Параллельное вычисление контрольной суммы
+     * @param root Указатель на корень дерева
+     * @param forkDepth Глубина ветвления задач (-1 - по числу ядер)
+     * @return Сумма ключей всех узлов дерева (64-битная)
+     */
+    static long long calculateCheckSum(TreeNode* root, int forkDepth = -1);
+
+    /**
+     * @brief Параллельное вычисление средней высоты (средней глубины листьев)
+     * @param root Указатель на корень дерева
+     * @param forkDepth Глубина ветвления задач (-1 - по числу ядер)
+     * @return Средняя глубина листьев (как TreeProperties::calculateAverageHeight)
+     */
+    static double calculateAverageHeight(TreeNode* root, int forkDepth = -1);
+
+    /**
+     * @brief Параллельная проверка свойства дерева поиска
+     * @param root Указатель на корень дерева
+     * @param forkDepth Глубина ветвления задач (-1 - по числу ядер)
+     * @return true если дерево является BST
+     */
+    static bool isBinarySearchTree(TreeNode* root, int forkDepth = -1);
+
+    /**
+     * @brief Глубина ветвления по умолчанию
+     * @return ceil(log2(число ядер)) + 2
+     *
+     * @note Задач создается примерно в 4 раза больше, чем ядер, чтобы
+     *       неравные по размеру поддеревья СДП не оставляли ядра без работы.
+     */
+    static int defaultForkDepth();
+};
+
+#endif // PARALLEL_PROPERTIES_H
@@ -0,0 +1,132 @@
+﻿/**
+ * @file perf_counters.cpp
+ * @brief Реализация чтения аппаратных счетчиков через perf_event_open
+ */
+
+#include "perf_counters.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cstring>
+#endif
+
+#ifdef __linux__
+/**
+ * @brief Открытие одного счетчика для текущего потока
+ * @param type Тип события (PERF_TYPE_HARDWARE или PERF_TYPE_HW_CACHE)
+ * @param config Код события
+ * @return Дескриптор счетчика или -1
+ *
+ * @details
+ * Счетчик создается выключенным и считает только пользовательский режим:
+ * так его разрешено открывать при perf_event_paranoid <= 2.
+ */
+static int openEvent(unsigned int type, unsigned long long config) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+/**
+ * @brief Код события кэша: (кэш, операция, результат)
+ */
+static unsigned long long cacheEvent(unsigned long long cache, unsigned long long result) {
+    return cache | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (result << 16);
+}
+#endif
+
+PerfCounters::PerfCounters() {
+    for (int& descriptor : descriptors) descriptor = -1;
+
+#ifdef __linux__
+    descriptors[static_cast<int>(PerfEvent::Cycles)] =
+        openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    descriptors[static_cast<int>(PerfEvent::Instructions)] =
+        openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    descriptors[static_cast<int>(PerfEvent::L1DMisses)] =
+        openEvent(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_L1D, PERF_COUNT_HW_CACHE_RESULT_MISS));
+    descriptors[static_cast<int>(PerfEvent::LLCMisses)] =
+        openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    descriptors[static_cast<int>(PerfEvent::BranchMisses)] =
+        openEvent(PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES);
+    descriptors[static_cast<int>(PerfEvent::DTLBMisses)] =
+        openEvent(PERF_TYPE_HW_CACHE, cacheEvent(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_RESULT_MISS));
+#endif
+}
+
+PerfCounters::~PerfCounters() {
+#ifdef __linux__
+    for (int descriptor : descriptors) {
+        if (descriptor >= 0) close(descriptor);
+    }
+#endif
+}
+
+bool PerfCounters::isAvailable() const {
+    for (int descriptor : descriptors) {
+        if (descriptor >= 0) return true;
+    }
+    return false;
+}
+
+void PerfCounters::start() {
+#ifdef __linux__
+    for (int descriptor : descriptors) {
+        if (descriptor < 0) continue;
+        ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+        ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+/**
+ * @brief Остановка и чтение счетчиков
+ *
+ * @details
+ * Каждый счетчик читается как тройка (значение, время включения,
+ * время работы). Если время работы меньше времени включения, счетчик
+ * делил PMU с другими и значение экстраполируется. Счетчик, который
+ * ни разу не был запущен или не прочитался, считается недоступным.
+ */
+PerfReading PerfCounters::stop() {
+    PerfReading reading;
+    for (long long& value : reading.values) value = -1;
+
+#ifdef __linux__
+    for (int descriptor : descriptors) {
+        if (descriptor >= 0) ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+    }
+    for (int i = 0; i < PERF_EVENT_COUNT; i++) {
+        if (descriptors[i] < 0) continue;
+        unsigned long long data[3];
+        if (read(descriptors[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data))) continue;
+        if (data[2] == 0) continue;
+        double scale = static_cast<double>(data[1]) / data[2];
+        reading.values[i] = static_cast<long long>(data[0] * scale);
+    }
+#endif
+
+    return reading;
+}
+
+const char* PerfCounters::eventName(PerfEvent event) {
+    switch (event) {
+    case PerfEvent::Cycles: return "такты";
+    case PerfEvent::Instructions: return "инстр.";
+    case PerfEvent::L1DMisses: return "пром. L1D";
+    case PerfEvent::LLCMisses: return "пром. LLC";
+    case PerfEvent::BranchMisses: return "пром. перех.";
+    case PerfEvent::DTLBMisses: return "пром. dTLB";
+    }
+    return "?";
+}
@@ -0,0 +1,112 @@
+﻿#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+/**
+ * @file perf_counters.h
+ * @brief Аппаратные счетчики производительности (Linux perf_event_open)
+ *
+ * Оборачивает замеряемый участок (построение, поиск) и читает счетчики
+ * процессора: такты, инструкции, промахи L1D и последнего уровня кэша,
+ * ошибки предсказания переходов и промахи dTLB. Деление на число ключей
+ * показывает, во что обходится один ключ и упирается ли обход узлов
+ * TreeNode или DBNode в промахи памяти.
+ *
+ * Вне Linux, а также когда ядро не дает открыть счетчик (perf_event_paranoid,
+ * контейнер, виртуальная машина без PMU), счетчик помечается недоступным,
+ * а замер продолжает работать - недоступные значения выводятся как "н/д".
+ */
+
+/**
+ * @brief Аппаратное событие
+ */
+enum class PerfEvent : int {
+    Cycles,         // Такты процессора
+    Instructions,   // Выполненные инструкции
+    L1DMisses,      // Промахи чтения кэша данных L1
+    LLCMisses,      // Промахи кэша последнего уровня
+    BranchMisses,   // Ошибки предсказания переходов
+    DTLBMisses      // Промахи чтения TLB данных
+};
+
+/// Количество событий PerfEvent
+const int PERF_EVENT_COUNT = 6;
+
+/**
+ * @brief Значения счетчиков за один замер
+ */
+struct PerfReading {
+    long long values[PERF_EVENT_COUNT];  // -1, если счетчик недоступен
+
+    /**
+     * @brief Был ли счетчик доступен во время замера
+     * @param event Событие
+     */
+    bool available(PerfEvent event) const {
+        return values[static_cast<int>(event)] >= 0;
+    }
+
+    /**
+     * @brief Значение счетчика на один ключ
+     * @param event Событие
+     * @param keys Количество ключей (операций) в замере
+     * @return Значение на ключ или -1, если счетчик недоступен
+     */
+    double perKey(PerfEvent event, long long keys) const {
+        if (!available(event) || keys <= 0) return -1;
+        return static_cast<double>(values[static_cast<int>(event)]) / keys;
+    }
+};
+
+/**
+ * @brief Набор счетчиков текущего потока
+ *
+ * Счетчики открываются в конструкторе и закрываются в деструкторе.
+ * Считается только пользовательский код текущего потока (без ядра).
+ * Если процессор мультиплексирует счетчики, значения масштабируются
+ * по доле времени, в течение которого счетчик был активен.
+ */
+class PerfCounters {
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    /// Открыт хотя бы один счетчик
+    bool isAvailable() const;
+
+    /**
+     * @brief Обнуление и запуск счетчиков
+     */
+    void start();
+
+    /**
+     * @brief Остановка и чтение счетчиков
+     * @return Значения с момента последнего start()
+     */
+    PerfReading stop();
+
+    /**
+     * @brief Замер участка кода
+     * @param action Замеряемое действие
+     * @return Значения счетчиков за время выполнения action
+     */
+    template <typename Action>
+    PerfReading measure(Action action) {
+        start();
+        action();
+        return stop();
+    }
+
+    /**
+     * @brief Краткое название события для заголовков таблиц
+     * @param event Событие
+     */
+    static const char* eventName(PerfEvent event);
+
+private:
+    int descriptors[PERF_EVENT_COUNT];  // -1 для недоступных счетчиков
+};
+
+#endif // PERF_COUNTERS_H
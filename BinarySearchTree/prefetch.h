@@ -0,0 +1,30 @@
+﻿#ifndef PREFETCH_H
+#define PREFETCH_H
+
+/**
+ * @file prefetch.h
+ * @brief Программная предвыборка данных в кэш
+ *
+ * Используется пакетными функциями поиска: адрес следующего узла известен
+ * заранее, и его загрузка из памяти перекрывается работой над другими запросами.
+ */
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+/**
+ * @brief Подсказка процессору загрузить строку кэша с адресом address
+ * @param address Адрес данных (nullptr допустим и игнорируется)
+ */
+inline void prefetchRead(const void* address) {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    _mm_prefetch(static_cast<const char*>(address), _MM_HINT_T0);
+#elif defined(__GNUC__) || defined(__clang__)
+    __builtin_prefetch(address, 0, 3);
+#else
+    (void)address;
+#endif
+}
+
+#endif // PREFETCH_H
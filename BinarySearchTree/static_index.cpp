@@ -0,0 +1,255 @@
+﻿/**
+ * @file static_index.cpp
+ * @brief Реализация статического индекса в порядке Эйтцингера
+ */
+
+#include "static_index.h"
+#include "tree_traversal.h"
+#include "prefetch.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define STATIC_INDEX_MMAP
+#endif
+
+// Сигнатура и версия формата индекса
+static const char INDEX_MAGIC[4] = { 'B', 'S', 'T', 'I' };
+static const std::uint32_t INDEX_VERSION = 1;
+
+/**
+ * @brief Заголовок файла индекса (64 байта - одна строка кэша)
+ */
+struct IndexHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint64_t count;
+    char reserved[48];
+};
+
+static_assert(sizeof(IndexHeader) == 64, "Заголовок индекса должен занимать 64 байта");
+
+// ================== Запись ==================
+
+/**
+ * @brief Раскладка ключей в порядке Эйтцингера
+ * @param next Функция, возвращающая очередной ключ по возрастанию
+ *
+ * @details
+ * In-order обход неявного полного дерева (потомки узла k - 2k и 2k + 1)
+ * посещает узлы в порядке возрастания ключей, поэтому ключи можно брать
+ * из потока по одному. Стек явный, его глубина - log2(n).
+ */
+template <typename Next>
+static std::vector<int> eytzingerLayout(std::size_t count, Next next) {
+    std::vector<int> layout(count + 1, 0);
+    std::vector<std::size_t> stack;
+    std::size_t k = 1;
+    while (k <= count || !stack.empty()) {
+        while (k <= count) {
+            stack.push_back(k);
+            k *= 2;
+        }
+        k = stack.back();
+        stack.pop_back();
+        layout[k] = next();
+        k = 2 * k + 1;
+    }
+    return layout;
+}
+
+/**
+ * @brief Запись заголовка и элементов в файл
+ */
+static long long writeIndex(const std::vector<int>& layout, const std::string& path) {
+    IndexHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, INDEX_MAGIC, 4);
+    header.version = INDEX_VERSION;
+    header.count = layout.size() - 1;
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось создать файл индекса " << path << std::endl;
+        return -1;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+        std::fwrite(layout.data(), sizeof(int), layout.size(), file) == layout.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Предупреждение: ошибка записи файла индекса " << path << std::endl;
+        return -1;
+    }
+    return static_cast<long long>(sizeof(header) + layout.size() * sizeof(int));
+}
+
+long long StaticIndex::write(const std::vector<int>& sortedKeys, const std::string& path) {
+    if (!std::is_sorted(sortedKeys.begin(), sortedKeys.end())) {
+        std::cerr << "Предупреждение: ключи для StaticIndex не отсортированы!" << std::endl;
+        return -1;
+    }
+    std::size_t position = 0;
+    return writeIndex(eytzingerLayout(sortedKeys.size(), [&]() { return sortedKeys[position++]; }), path);
+}
+
+/**
+ * @brief Запись индекса по дереву
+ *
+ * Два ленивых in-order обхода: первый считает ключи, второй раскладывает
+ * их - вектор всех ключей в порядке возрастания не строится.
+ */
+long long StaticIndex::write(TreeNode* root, const std::string& path) {
+    std::size_t count = 0;
+    for (InOrderIterator it(root), end; it != end; ++it) count++;
+
+    InOrderIterator it(root);
+    return writeIndex(eytzingerLayout(count, [&]() { return *it++; }), path);
+}
+
+// ================== Чтение ==================
+
+StaticIndex::~StaticIndex() {
+    close();
+}
+
+/**
+ * @brief Открытие индекса
+ *
+ * @details
+ * POSIX: файл отображается только для чтения (MAP_SHARED), дескриптор
+ * сразу закрывается - отображение остается действительным.
+ * Windows: CreateFileMapping + MapViewOfFile, файл тоже закрывается
+ * сразу, объект отображения - в close().
+ */
+bool StaticIndex::open(const std::string& path) {
+    close();
+
+#if defined(STATIC_INDEX_MMAP)
+    int descriptor = ::open(path.c_str(), O_RDONLY);
+    if (descriptor < 0) {
+        std::cerr << "Предупреждение: не удалось открыть файл индекса " << path << std::endl;
+        return false;
+    }
+    struct stat status;
+    void* data = MAP_FAILED;
+    if (fstat(descriptor, &status) == 0 && status.st_size > 0) {
+        data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+    }
+    ::close(descriptor);
+    if (data != MAP_FAILED) {
+        view = data;
+        viewBytes = static_cast<std::size_t>(status.st_size);
+    }
+#elif defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+        OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        std::cerr << "Предупреждение: не удалось открыть файл индекса " << path << std::endl;
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        HANDLE handle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (handle) {
+            void* data = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+            if (data) {
+                view = data;
+                viewBytes = static_cast<std::size_t>(fileSize.QuadPart);
+                mapping = handle;
+            }
+            else {
+                CloseHandle(handle);
+            }
+        }
+    }
+    CloseHandle(file);
+#endif
+
+    if (view) {
+        if (attach(view, viewBytes, path)) return true;
+        close();
+        return false;
+    }
+
+    // Без отображения: чтение файла целиком
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось открыть файл индекса " << path << std::endl;
+        return false;
+    }
+    std::vector<char> bytes;
+    char chunk[1 << 16];
+    std::size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0) bytes.insert(bytes.end(), chunk, chunk + read);
+    std::fclose(file);
+
+    buffer.resize((bytes.size() + sizeof(int) - 1) / sizeof(int));
+    if (!bytes.empty()) std::memcpy(buffer.data(), bytes.data(), bytes.size());
+    if (attach(buffer.data(), bytes.size(), path)) return true;
+    close();
+    return false;
+}
+
+bool StaticIndex::attach(const void* data, std::size_t bytes, const std::string& path) {
+    const IndexHeader* header = static_cast<const IndexHeader*>(data);
+    if (bytes < sizeof(IndexHeader) || std::memcmp(header->magic, INDEX_MAGIC, 4) != 0 ||
+        header->version != INDEX_VERSION) {
+        std::cerr << "Предупреждение: " << path << " не является файлом индекса" << std::endl;
+        return false;
+    }
+    if (header->count >= bytes || bytes - sizeof(IndexHeader) != (header->count + 1) * sizeof(int)) {
+        std::cerr << "Предупреждение: индекс " << path << " обрезан или поврежден" << std::endl;
+        return false;
+    }
+    keys = reinterpret_cast<const int*>(static_cast<const char*>(data) + sizeof(IndexHeader));
+    count = static_cast<std::size_t>(header->count);
+    return true;
+}
+
+void StaticIndex::close() {
+#if defined(STATIC_INDEX_MMAP)
+    if (view) munmap(view, viewBytes);
+#elif defined(_WIN32)
+    if (view) UnmapViewOfFile(view);
+    if (mapping) CloseHandle(static_cast<HANDLE>(mapping));
+#endif
+    view = nullptr;
+    viewBytes = 0;
+    mapping = nullptr;
+    buffer.clear();
+    buffer.shrink_to_fit();
+    keys = nullptr;
+    count = 0;
+}
+
+/**
+ * @brief Поиск ключа спуском по неявному дереву
+ *
+ * @details
+ * Как в searchNode: равенство - найдено, иначе переход к левому (2k)
+ * или правому (2k + 1) потомку. Узлы 16k..16k + 15 - правнуки
+ * четвертого поколения - лежат в одной строке кэша и запрашиваются
+ * заранее, так что загрузка памяти идет на четыре уровня вперед.
+ * На последних четырех уровнях правнуков нет, и адрес за концом
+ * массива не вычисляется.
+ */
+const int* StaticIndex::search(int key) const {
+    std::size_t k = 1;
+    while (k <= count) {
+        if (16 * k <= count) prefetchRead(keys + 16 * k);
+        int current = keys[k];
+        if (key == current) return keys + k;
+        k = 2 * k + (key > current ? 1 : 0);
+    }
+    return nullptr;
+}
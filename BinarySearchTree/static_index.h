@@ -0,0 +1,92 @@
+﻿#ifndef STATIC_INDEX_H
+#define STATIC_INDEX_H
+
+#include "tree_node.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @file static_index.h
+ * @brief Статический индекс ключей в файле, читаемый через отображение в память
+ *
+ * Отсортированные ключи (те, из которых строится ИСДП) записываются
+ * в файл в порядке Эйтцингера: ключ i-го узла полного дерева поиска лежит
+ * в элементе i, его потомки - в 2i и 2i + 1. Поиск - тот же спуск, что
+ * и TreeProperties::searchNode, только вместо указателей - индексы,
+ * а первые уровни дерева лежат в нескольких соседних строках кэша.
+ *
+ * Файл открывается через mmap (POSIX) или MapViewOfFile (Windows) и
+ * используется на месте: при открытии нет разбора, выделений памяти
+ * и построения, страницы подгружаются при первом обращении, а несколько
+ * процессов с одним индексом делят страничный кэш. На других платформах
+ * файл читается в память целиком.
+ *
+ * Формат: заголовок 64 байта (сигнатура "BSTI", версия, число ключей),
+ * затем int32 элементы 0..n в порядке байт машины; элемент 0 не используется,
+ * поэтому блоки по 16 элементов выровнены на 64 байта.
+ */
+class StaticIndex {
+public:
+    /**
+     * @brief Запись индекса по отсортированным ключам
+     * @param sortedKeys Ключи по возрастанию
+     * @param path Путь к файлу (перезаписывается)
+     * @return Размер файла в байтах (-1 при ошибке или неотсортированных ключах)
+     */
+    static long long write(const std::vector<int>& sortedKeys, const std::string& path);
+
+    /**
+     * @brief Запись индекса по ключам дерева поиска
+     * @param root Корень дерева (ключи берутся ленивым in-order обходом)
+     * @param path Путь к файлу (перезаписывается)
+     * @return Размер файла в байтах (-1 при ошибке)
+     */
+    static long long write(TreeNode* root, const std::string& path);
+
+    StaticIndex() = default;
+    ~StaticIndex();
+
+    StaticIndex(const StaticIndex&) = delete;
+    StaticIndex& operator=(const StaticIndex&) = delete;
+
+    /**
+     * @brief Открытие индекса (предыдущий закрывается)
+     * @param path Путь к файлу индекса
+     * @return true при успехе
+     */
+    bool open(const std::string& path);
+
+    /// Закрытие индекса: отображение снимается, указатели из search() недействительны
+    void close();
+
+    bool isOpen() const { return keys != nullptr; }
+
+    /// Отображен ли файл в память (false - прочитан в буфер)
+    bool isMapped() const { return view != nullptr; }
+
+    /// Количество ключей
+    std::size_t size() const { return count; }
+
+    /**
+     * @brief Поиск ключа (семантика TreeProperties::searchNode)
+     * @param key Искомый ключ
+     * @return Указатель на ключ внутри индекса или nullptr
+     */
+    const int* search(int key) const;
+
+    bool contains(int key) const { return search(key) != nullptr; }
+
+private:
+    /// Проверка заголовка и установка keys/count по началу данных файла
+    bool attach(const void* data, std::size_t bytes, const std::string& path);
+
+    const int* keys = nullptr;     // Элементы 0..count (элемент 0 не используется)
+    std::size_t count = 0;
+    void* view = nullptr;          // Отображение файла
+    std::size_t viewBytes = 0;
+    void* mapping = nullptr;       // Объект отображения (Windows)
+    std::vector<int> buffer;       // Файл, прочитанный в память, если отображения нет
+};
+
+#endif // STATIC_INDEX_H
@@ -0,0 +1,131 @@
+﻿/**
+ * @file succinct_tree.cpp
+ * @brief Реализация компактного представления бинарного дерева поиска
+ */
+
+#include "succinct_tree.h"
+#include <algorithm>
+#include <deque>
+
+/**
+ * @brief Число единичных битов слова
+ */
+static unsigned popcount(std::uint64_t value) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_popcountll(value));
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<unsigned>((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// Слов в блоке таблицы рангов
+static const std::size_t WORDS_PER_BLOCK = 8;
+
+// ================== RankBitVector ==================
+
+void RankBitVector::push(bool bit) {
+    if ((bitCount & 63) == 0) words.push_back(0);
+    if (bit) words.back() |= 1ULL << (bitCount & 63);
+    bitCount++;
+}
+
+void RankBitVector::finish() {
+    blockRanks.assign(words.size() / WORDS_PER_BLOCK + 1, 0);
+    std::uint32_t ones = 0;
+    for (std::size_t word = 0; word < words.size(); word++) {
+        if (word % WORDS_PER_BLOCK == 0) blockRanks[word / WORDS_PER_BLOCK] = ones;
+        ones += popcount(words[word]);
+    }
+    if (words.size() % WORDS_PER_BLOCK == 0) blockRanks.back() = ones;
+}
+
+/**
+ * @brief Ранг: число единиц до позиции index
+ *
+ * Берется счетчик блока, затем досчитываются не больше 7 целых слов
+ * и начало слова, в котором лежит index.
+ */
+std::size_t RankBitVector::rank(std::size_t index) const {
+    std::size_t word = index >> 6;
+    std::size_t ones = blockRanks[word / WORDS_PER_BLOCK];
+    for (std::size_t w = word - word % WORDS_PER_BLOCK; w < word; w++) ones += popcount(words[w]);
+    if (index & 63) ones += popcount(words[word] & ((1ULL << (index & 63)) - 1));
+    return ones;
+}
+
+std::size_t RankBitVector::memoryBytes() const {
+    return words.size() * sizeof(std::uint64_t) + blockRanks.size() * sizeof(std::uint32_t);
+}
+
+// ================== PackedIntArray ==================
+
+/**
+ * @brief Упаковка значений
+ *
+ * Ширина - число битов в max - min. Массив дополнен одним словом, чтобы
+ * get() всегда мог прочитать два соседних слова.
+ */
+PackedIntArray::PackedIntArray(const std::vector<int>& values) : count(values.size()) {
+    if (values.empty()) return;
+    auto bounds = std::minmax_element(values.begin(), values.end());
+    base = *bounds.first;
+    std::uint64_t range = static_cast<std::uint64_t>(static_cast<long long>(*bounds.second) - base);
+    while (width < 64 && (range >> width) != 0) width++;
+    mask = width == 0 ? 0 : (~0ULL >> (64 - width));
+
+    words.assign((count * width + 63) / 64 + 1, 0);
+    for (std::size_t i = 0; i < count; i++) {
+        std::uint64_t value = static_cast<std::uint64_t>(static_cast<long long>(values[i]) - base);
+        std::size_t bit = i * width;
+        unsigned shift = bit & 63;
+        words[bit >> 6] |= value << shift;
+        if (shift + width > 64) words[(bit >> 6) + 1] |= value >> (64 - shift);
+    }
+}
+
+// ================== SuccinctTree ==================
+
+const long long SuccinctTree::NONE;
+
+/**
+ * @brief Построение обходом по уровням
+ *
+ * Для каждого узла в порядке обхода записываются его ключ и два бита
+ * формы. Номер потомка в обходе по уровням равен числу уже встреченных
+ * потомков плюс один (корень), то есть rank единиц формы до бита
+ * потомка включительно - на этом основаны left() и right().
+ */
+SuccinctTree::SuccinctTree(TreeNode* root) {
+    std::vector<int> levelOrderKeys;
+    std::deque<std::pair<TreeNode*, int>> queue;
+    if (root) queue.push_back({ root, 1 });
+
+    while (!queue.empty()) {
+        TreeNode* node = queue.front().first;
+        int depth = queue.front().second;
+        queue.pop_front();
+
+        levelOrderKeys.push_back(node->key);
+        treeHeight = std::max(treeHeight, depth);
+        shape.push(node->left != nullptr);
+        shape.push(node->right != nullptr);
+        if (node->left) queue.push_back({ node->left, depth + 1 });
+        if (node->right) queue.push_back({ node->right, depth + 1 });
+    }
+
+    shape.finish();
+    keys = PackedIntArray(levelOrderKeys);
+}
+
+long long SuccinctTree::search(int key) const {
+    long long node = root();
+    while (node != NONE) {
+        int current = this->key(node);
+        if (key == current) return node;
+        node = key < current ? left(node) : right(node);
+    }
+    return NONE;
+}
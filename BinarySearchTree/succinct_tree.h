@@ -0,0 +1,154 @@
+﻿#ifndef SUCCINCT_TREE_H
+#define SUCCINCT_TREE_H
+
+#include "tree_node.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file succinct_tree.h
+ * @brief Компактное неизменяемое представление бинарного дерева поиска
+ *
+ * Узел TreeNode на 64-битной платформе занимает 32 байта (ключ, два
+ * указателя, высота и выравнивание) плюс служебные байты кучи. Для
+ * деревьев, которые после построения только читаются, SuccinctTree хранит:
+ * - форму: 2 бита на узел (есть левый / правый потомок) в порядке обхода
+ *   по уровням, плюс таблицу рангов - около 2.125 бита на узел;
+ * - ключи в том же порядке, упакованные до ширины max - min.
+ *
+ * Узлы нумеруются по уровням, корень - 0. Если у узла i есть левый
+ * потомок, его номер - число единиц в битах формы [0, 2i] (с учетом
+ * самого бита 2i), правого - число единиц в [0, 2i + 1]. Поэтому переход
+ * к потомку - одна операция rank, а указатели не нужны.
+ */
+
+/**
+ * @brief Битовый вектор с rank за O(1)
+ *
+ * Каждые 512 бит (8 слов) хранится число единиц до начала блока,
+ * внутри блока единицы досчитываются popcount по словам.
+ */
+class RankBitVector {
+public:
+    /// Добавление бита в конец (только до первого rank)
+    void push(bool bit);
+
+    /// Построение таблицы рангов; вызывается после всех push
+    void finish();
+
+    /// Значение бита
+    bool get(std::size_t index) const {
+        return (words[index >> 6] >> (index & 63)) & 1;
+    }
+
+    /**
+     * @brief Число единиц в позициях [0, index)
+     * @param index Позиция (0..size())
+     */
+    std::size_t rank(std::size_t index) const;
+
+    std::size_t size() const { return bitCount; }
+
+    /// Занятая память в байтах (биты и таблица рангов)
+    std::size_t memoryBytes() const;
+
+private:
+    std::vector<std::uint64_t> words;
+    std::vector<std::uint32_t> blockRanks;  // Единиц до начала каждого блока из 8 слов
+    std::size_t bitCount = 0;
+};
+
+/**
+ * @brief Массив целых фиксированной ширины в битах
+ *
+ * Хранит value - base шириной, достаточной для max - min.
+ */
+class PackedIntArray {
+public:
+    PackedIntArray() = default;
+
+    /**
+     * @param values Значения
+     */
+    explicit PackedIntArray(const std::vector<int>& values);
+
+    int get(std::size_t index) const {
+        std::size_t bit = index * width;
+        std::size_t word = bit >> 6;
+        unsigned shift = bit & 63;
+        std::uint64_t value = words[word] >> shift;
+        if (shift + width > 64) value |= words[word + 1] << (64 - shift);
+        return static_cast<int>(base + static_cast<long long>(value & mask));
+    }
+
+    std::size_t size() const { return count; }
+
+    /// Ширина значения в битах
+    unsigned bitWidth() const { return width; }
+
+    /// Занятая память в байтах
+    std::size_t memoryBytes() const { return words.size() * sizeof(std::uint64_t); }
+
+private:
+    std::vector<std::uint64_t> words;
+    long long base = 0;
+    std::uint64_t mask = 0;
+    unsigned width = 0;
+    std::size_t count = 0;
+};
+
+class SuccinctTree {
+public:
+    /// Номер отсутствующего узла
+    static const long long NONE = -1;
+
+    /**
+     * @brief Построение по бинарному дереву поиска
+     * @param root Корень дерева (nullptr - пустое дерево); само дерево не меняется
+     */
+    explicit SuccinctTree(TreeNode* root);
+
+    /// Количество узлов
+    std::size_t size() const { return keys.size(); }
+
+    /// Номер корня (NONE для пустого дерева)
+    long long root() const { return keys.size() > 0 ? 0 : NONE; }
+
+    /// Ключ узла
+    int key(long long node) const { return keys.get(static_cast<std::size_t>(node)); }
+
+    /// Левый потомок узла или NONE
+    long long left(long long node) const {
+        std::size_t bit = 2 * static_cast<std::size_t>(node);
+        return shape.get(bit) ? static_cast<long long>(shape.rank(bit + 1)) : NONE;
+    }
+
+    /// Правый потомок узла или NONE
+    long long right(long long node) const {
+        std::size_t bit = 2 * static_cast<std::size_t>(node) + 1;
+        return shape.get(bit) ? static_cast<long long>(shape.rank(bit + 1)) : NONE;
+    }
+
+    /**
+     * @brief Поиск ключа (аналог TreeProperties::searchNode)
+     * @param key Искомый ключ
+     * @return Номер узла с ключом или NONE
+     */
+    long long search(int key) const;
+
+    /// Высота дерева (для пустого 0)
+    int height() const { return treeHeight; }
+
+    /// Занятая память в байтах (форма, ранги и ключи)
+    std::size_t memoryBytes() const { return shape.memoryBytes() + keys.memoryBytes(); }
+
+    /// Ширина упакованного ключа в битах
+    unsigned keyBits() const { return keys.bitWidth(); }
+
+private:
+    RankBitVector shape;
+    PackedIntArray keys;
+    int treeHeight = 0;
+};
+
+#endif // SUCCINCT_TREE_H
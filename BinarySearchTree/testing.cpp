@@ -7,9 +7,31 @@
 #include "data_generator.h"
 #include "tree_builders.h"
 #include "tree_properties.h"
+#include "tree_digest.h"
+#include "parallel_properties.h"
+#include "key_source.h"
+#include "workload.h"
+#include "op_stats.h"
+#include "perf_counters.h"
+#include "node_memory.h"
+#include "memory_utils.h"
+#include "huge_page_arena.h"
+#include "output_sink.h"
+#include "output_utils.h"
+#include "tree_traversal.h"
+#include "tree_snapshot.h"
+#include "succinct_tree.h"
+#include "static_index.h"
+#include "concurrent_avl.h"
+#include "epoch_reclamation.h"
 #include <iostream>
 #include <algorithm>
 #include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <thread>
 
  /**
   * @brief Демонстрация построения ИСДП
@@ -191,6 +213,1577 @@ void Testing::demonstrateDBTree() {
     std::cout << std::endl;
 }
 
+/**
+ * @brief Демонстрация перебалансировки DSW
+ *
+ * @details
+ * СДП, построенное из отсортированных данных, вырождается в список.
+ * Перебалансировка DSW переиспользует те же узлы и дает дерево минимальной высоты:
+ * - Размер не меняется (1000 вершин)
+ * - Высота падает с 1000 до 10
+ * - Свойство BST сохраняется
+ * - Повторный вызов не перестраивает уже сбалансированное дерево
+ */
+void Testing::demonstrateDSWRebalance() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ DSW ===" << std::endl;
+
+    // Отсортированные данные дают вырожденное СДП
+    std::vector<int> data;
+    for (int i = 1; i <= 1000; i++) data.push_back(i);
+    TreeNode* spTree = TreeBuilders::buildRandomSearchTree(data);
+    TreeNode* oldRoot = spTree;
+
+    std::cout << "+ Высота до: " << TreeProperties::calculateHeight(spTree) << std::endl;
+
+    bool rebalanced = TreeBuilders::rebalanceIfDegenerate(spTree);
+
+    // Проверка свойств после перебалансировки
+    assert(rebalanced);
+    assert(spTree != oldRoot);
+    assert(TreeProperties::calculateSize(spTree) == 1000);
+    assert(TreeProperties::calculateHeight(spTree) == 10);
+    assert(spTree->height == 10);
+    assert(TreeBuilders::isBinarySearchTree(spTree));
+    assert(!TreeBuilders::rebalanceIfDegenerate(spTree));
+
+    std::cout << "+ Высота после: " << TreeProperties::calculateHeight(spTree) << std::endl;
+    std::cout << "+ Размер: " << TreeProperties::calculateSize(spTree) << " вершин" << std::endl;
+    std::cout << "+ Является BST: ДА" << std::endl;
+
+    // Очистка памяти
+    TreeBuilders::deleteTree(spTree);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация параллельного вычисления характеристик
+ *
+ * @details
+ * Строит СДП из 200000 случайных ключей и проверяет, что параллельные версии
+ * дают те же размер, высоту, контрольную сумму, среднюю высоту и результат
+ * BST-проверки, что и последовательные. Дополнительно проверяются вырожденное
+ * дерево, на котором параллельная свертка не должна ветвиться, дерево с
+ * нарушенной границей глубоко в поддереве и зигзаг глубиной 50001.
+ */
+void Testing::demonstrateParallelProperties() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ПАРАЛЛЕЛЬНЫХ ХАРАКТЕРИСТИК ===" << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(200000, 1, 2000000);
+    TreeNode* spTree = TreeBuilders::buildRandomSearchTree(data);
+
+    // Сравнение с последовательными версиями
+    assert(ParallelProperties::calculateSize(spTree) == TreeProperties::calculateSize(spTree));
+    assert(ParallelProperties::calculateHeight(spTree) == TreeProperties::calculateHeight(spTree));
+    assert(ParallelProperties::calculateCheckSum(spTree) == TreeProperties::calculateCheckSum(spTree));
+    assert(ParallelProperties::calculateAverageHeight(spTree) == TreeProperties::calculateAverageHeight(spTree));
+    assert(ParallelProperties::isBinarySearchTree(spTree));
+
+    // Вырожденное дерево: цепочка проходится без ветвления задач
+    std::vector<int> sortedData = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    TreeNode* chain = TreeBuilders::buildRandomSearchTree(sortedData);
+    assert(ParallelProperties::calculateSize(chain) == 10);
+    assert(ParallelProperties::calculateHeight(chain) == 10);
+    assert(ParallelProperties::calculateAverageHeight(chain) == 9.0);
+    assert(ParallelProperties::isBinarySearchTree(chain));
+
+    // Нарушение границы глубоко в левом поддереве: наибольший ключ
+    // левого поддерева становится больше корня, локально порядок не нарушен
+    TreeNode* deepest = spTree->left;
+    while (deepest->right != nullptr) deepest = deepest->right;
+    int savedKey = deepest->key;
+    deepest->key = spTree->key + 1;
+    for (int forkDepth : { 0, 1, -1 }) {
+        assert(!ParallelProperties::isBinarySearchTree(spTree, forkDepth));
+    }
+    deepest->key = savedKey;
+    assert(ParallelProperties::isBinarySearchTree(spTree));
+
+    // Зигзаг глубиной 50001: у каждого узла хребта есть лист слева, поэтому
+    // это не цепочка, и ниже глубины ветвления свертка идет без рекурсии
+    const int spine = 50000;
+    TreeNode* zigzag = new TreeNode(2);
+    TreeNode* node = zigzag;
+    node->left = new TreeNode(1);
+    for (int i = 2; i <= spine; i++) {
+        node->right = new TreeNode(2 * i);
+        node = node->right;
+        node->left = new TreeNode(2 * i - 1);
+    }
+    for (int forkDepth : { 0, -1 }) {
+        assert(ParallelProperties::calculateSize(zigzag, forkDepth) == 2 * spine);
+        assert(ParallelProperties::calculateHeight(zigzag, forkDepth) == spine + 1);
+        assert(ParallelProperties::calculateCheckSum(zigzag, forkDepth) == static_cast<long long>(spine) * (2 * spine + 1));
+        assert(ParallelProperties::isBinarySearchTree(zigzag, forkDepth));
+    }
+    while (zigzag != nullptr) {
+        TreeNode* next = zigzag->right;
+        delete zigzag->left;
+        delete zigzag;
+        zigzag = next;
+    }
+    std::cout << "+ Нарушение порядка в глубине поддерева найдено, зигзаг глубиной "
+        << spine + 1 << " свернут без рекурсии" << std::endl;
+
+    std::cout << "+ Глубина ветвления: " << ParallelProperties::defaultForkDepth() << std::endl;
+    std::cout << "+ Размер: " << ParallelProperties::calculateSize(spTree) << " вершин" << std::endl;
+    std::cout << "+ Высота: " << ParallelProperties::calculateHeight(spTree) << std::endl;
+    std::cout << "+ Результаты совпадают с последовательными" << std::endl;
+
+    // Очистка памяти
+    TreeBuilders::deleteTree(spTree);
+    TreeBuilders::deleteTree(chain);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Листья и сумма глубин узлов бинарного дерева (рекурсивно)
+ */
+static void countLeaves(TreeNode* node, int depth, int& leaves, long long& pathLength) {
+    if (!node) return;
+    pathLength += depth;
+    if (!node->left && !node->right) leaves++;
+    countLeaves(node->left, depth + 1, leaves, pathLength);
+    countLeaves(node->right, depth + 1, leaves, pathLength);
+}
+
+/**
+ * @brief Листовые узлы ДБД и сумма их глубин (рекурсивно)
+ */
+static void countLeavesDB(DBNode* node, int depth, int& leaves, long long& depthSum) {
+    if (!node) return;
+    if (node->isLeaf) {
+        leaves++;
+        depthSum += depth;
+        return;
+    }
+    for (DBNode* child : node->children) countLeavesDB(child, depth + 1, leaves, depthSum);
+}
+
+/**
+ * @brief Совпадают ли TreeStats с отдельными функциями calculate*
+ */
+static bool statsMatch(TreeNode* root, const TreeStats& stats) {
+    int leaves = 0;
+    long long pathLength = 0;
+    countLeaves(root, 0, leaves, pathLength);
+    return stats.size == TreeProperties::calculateSize(root) &&
+        stats.height == TreeProperties::calculateHeight(root) &&
+        stats.checkSum == TreeProperties::calculateCheckSum(root) &&
+        stats.fingerprint == TreeProperties::calculateFingerprint(root) &&
+        stats.averageLeafDepth == TreeProperties::calculateAverageHeight(root) &&
+        stats.leafCount == leaves && stats.internalPathLength == pathLength &&
+        static_cast<int>(stats.levelWidths.size()) == stats.height;
+}
+
+/**
+ * @brief Демонстрация сводных характеристик за один обход
+ *
+ * @details
+ * Проверяет calculateStats и calculateStatsDB на деревьях, построенных
+ * вручную, и на случайных деревьях всех видов, сравнивая поля TreeStats
+ * с отдельными функциями calculate*.
+ */
+void Testing::demonstrateTreeStats() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ СВОДНЫХ ХАРАКТЕРИСТИК ===" << std::endl;
+
+    // Тестовое дерево: 5 (3 (1) (4)) (8 () (9))
+    TreeNode* tree = createTestTree();
+    TreeStats stats = TreeProperties::calculateStats(tree);
+    assert(stats.size == 6 && stats.height == 3 && stats.checkSum == 30);
+    assert(stats.leafCount == 3 && stats.averageLeafDepth == 2.0);
+    assert(stats.internalPathLength == 0 + 1 + 1 + 2 + 2 + 2);
+    assert((stats.levelWidths == std::vector<int>{ 1, 2, 3 }));
+    unsigned long long fingerprint = 0;
+    for (int key : { 1, 3, 4, 5, 8, 9 }) fingerprint += TreeDigest::mixKey(key);
+    assert(stats.fingerprint == fingerprint);
+    assert(statsMatch(tree, stats));
+    TreeBuilders::deleteTree(tree);
+
+    TreeStats empty = TreeProperties::calculateStats(nullptr);
+    assert(empty.size == 0 && empty.height == 0 && empty.leafCount == 0 && empty.levelWidths.empty());
+
+    // ДБД: корень {10} и листья {5, 7}, {12}
+    DBNode* db = new DBNode(false, 0);
+    db->keys.push_back(10);
+    db->children.push_back(new DBNode(true, 1));
+    db->children.push_back(new DBNode(true, 1));
+    db->children[0]->keys.push_back(5);
+    db->children[0]->keys.push_back(7);
+    db->children[1]->keys.push_back(12);
+    stats = TreeProperties::calculateStatsDB(db);
+    assert(stats.size == 4 && stats.height == 2 && stats.checkSum == 34);
+    assert(stats.leafCount == 2 && stats.averageLeafDepth == 1.0);
+    assert(stats.internalPathLength == 3 && (stats.levelWidths == std::vector<int>{ 1, 3 }));
+    assert(stats.fingerprint == TreeProperties::calculateFingerprintDB(db));
+    TreeBuilders::deleteDBTree(db);
+    std::cout << "+ Деревья, построенные вручную: все поля совпадают с ожидаемыми" << std::endl;
+
+    // Случайные деревья всех видов
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(20000, 1, 200000, 67);
+    std::vector<int> sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+    TreeNode* trees[] = {
+        TreeBuilders::buildPerfectlyBalancedTree(sorted),
+        TreeBuilders::buildRandomSearchTree(data),
+        TreeBuilders::buildAVLTree(data),
+    };
+    for (TreeNode* root : trees) {
+        assert(statsMatch(root, TreeProperties::calculateStats(root)));
+        TreeBuilders::deleteTree(root);
+    }
+
+    for (int t : { 2, 5 }) {
+        DBNode* dbTree = TreeBuilders::buildDBTree(data, t);
+        stats = TreeProperties::calculateStatsDB(dbTree);
+        assert(stats.size == static_cast<int>(data.size()));
+        assert(stats.height == TreeProperties::calculateHeightDB(dbTree));
+        assert(stats.checkSum == TreeProperties::calculateCheckSumDB(dbTree));
+        assert(stats.fingerprint == TreeProperties::calculateFingerprintDB(dbTree));
+        assert(stats.internalPathLength == TreeProperties::calculateLevelsDB(dbTree));
+        int leaves = 0;
+        long long leafDepthSum = 0;
+        countLeavesDB(dbTree, 0, leaves, leafDepthSum);
+        assert(stats.leafCount == leaves);
+        assert(stats.averageLeafDepth == static_cast<double>(leafDepthSum) / leaves);
+        TreeBuilders::deleteDBTree(dbTree);
+    }
+    std::cout << "+ ИСДП, СДП, АВЛ и ДБД из 20000 ключей: TreeStats совпадает с calculate*" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Совпадает ли дайджест с обходом бинарного дерева
+ */
+static bool digestMatches(TreeNode* root, const TreeDigest& digest) {
+    return digest.checkSum == TreeProperties::calculateCheckSum(root) &&
+        digest.fingerprint == TreeProperties::calculateFingerprint(root) &&
+        digest.count == TreeProperties::calculateSize(root);
+}
+
+/**
+ * @brief Совпадает ли дайджест с обходом ДБД
+ */
+static bool digestMatchesDB(DBNode* root, const TreeDigest& digest) {
+    return digest.checkSum == TreeProperties::calculateCheckSumDB(root) &&
+        digest.fingerprint == TreeProperties::calculateFingerprintDB(root) &&
+        digest.count == TreeProperties::calculateStatsDB(root).size;
+}
+
+/**
+ * @brief Демонстрация инкрементального дайджеста
+ *
+ * @details
+ * Строит деревья всех видов из ключей с повторами, передавая дайджест
+ * построителям, и сравнивает его с обходом. Проверяет, что удаление
+ * отменяет вставку и что разные наборы ключей дают разные дайджесты.
+ */
+void Testing::demonstrateTreeDigest() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ДАЙДЖЕСТА ДЕРЕВА ===" << std::endl;
+
+    // 20000 ключей из 5000 значений - много повторов
+    std::vector<int> data = DataGenerator::generateRandomNumbers(20000, 1, 5000, 71);
+    std::vector<int> sorted = data;
+    std::sort(sorted.begin(), sorted.end());
+
+    TreeDigest ibDigest, spDigest, avlDigest, dbDigest;
+    TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sorted, &ibDigest);
+    TreeNode* spTree = TreeBuilders::buildRandomSearchTree(data, &spDigest);
+    TreeNode* avlTree = TreeBuilders::buildAVLTree(data, &avlDigest);
+    DBNode* dbTree = TreeBuilders::buildDBTree(data, 2, &dbDigest);
+    assert(digestMatches(ibTree, ibDigest) && digestMatches(spTree, spDigest));
+    assert(digestMatches(avlTree, avlDigest) && digestMatchesDB(dbTree, dbDigest));
+    // Повторы не вставляются в СДП, АВЛ и ДБД - наборы ключей одинаковы
+    assert(spDigest == avlDigest && avlDigest == dbDigest);
+    assert(spDigest.count < static_cast<long long>(data.size()));
+    std::cout << "+ ИСДП, СДП, АВЛ, ДБД: дайджест равен обходу, различных ключей "
+        << spDigest.count << " из " << data.size() << std::endl;
+
+    // Удаление через построители обновляет дайджест, отсутствующий ключ - нет
+    TreeDigest before = avlDigest;
+    int key = data[0];
+    avlTree = TreeBuilders::removeAVL(avlTree, key, &avlDigest);
+    assert(TreeBuilders::removeBST(spTree, key, &spDigest));
+    assert(TreeBuilders::removeDBNode(dbTree, key, 2, &dbDigest));
+    assert(avlDigest != before && spDigest == avlDigest && dbDigest == avlDigest);
+    assert(digestMatches(avlTree, avlDigest) && digestMatches(spTree, spDigest) && digestMatchesDB(dbTree, dbDigest));
+    avlTree = TreeBuilders::removeAVL(avlTree, key, &avlDigest);
+    assert(!TreeBuilders::removeBST(spTree, key, &spDigest) && spDigest == avlDigest);
+    avlTree = TreeBuilders::insertAVL(avlTree, key, &avlDigest);
+    avlTree = TreeBuilders::insertAVL(avlTree, key, &avlDigest);
+    assert(avlDigest == before && digestMatches(avlTree, avlDigest));
+
+    TreeDigest digest = before;
+    digest.add(-7);
+    assert(digest != before);
+    digest.remove(-7);
+    assert(digest == before);
+    std::cout << "+ Удаление отменяет вставку, повторная вставка и удаление отсутствующего не меняют дайджест" << std::endl;
+
+    // {1, 4} и {2, 3}: суммы и количества равны, отпечатки - нет
+    TreeDigest first, second;
+    first.add(1);
+    first.add(4);
+    second.add(2);
+    second.add(3);
+    assert(first.checkSum == second.checkSum && first.count == second.count);
+    assert(first.fingerprint != second.fingerprint && first != second);
+    second.remove(3);
+    second.add(4);
+    second.remove(2);
+    second.add(1);
+    assert(first == second);
+    std::cout << "+ Наборы {1, 4} и {2, 3} различаются, порядок вставки не важен" << std::endl;
+
+    TreeBuilders::deleteTree(ibTree);
+    TreeBuilders::deleteTree(spTree);
+    TreeBuilders::deleteTree(avlTree);
+    TreeBuilders::deleteDBTree(dbTree);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Ключи ленивого обхода в вектор
+ */
+template <typename Range>
+static std::vector<int> collectRange(const Range& range) {
+    return std::vector<int>(range.begin(), range.end());
+}
+
+// Рекурсивные обходы - эталон для итераторов
+
+static void preOrderRecursive(TreeNode* node, std::vector<int>& keys) {
+    if (!node) return;
+    keys.push_back(node->key);
+    preOrderRecursive(node->left, keys);
+    preOrderRecursive(node->right, keys);
+}
+
+static void levelsRecursive(TreeNode* node, size_t depth, std::vector<std::vector<int>>& levels) {
+    if (!node) return;
+    if (depth == levels.size()) levels.emplace_back();
+    levels[depth].push_back(node->key);
+    levelsRecursive(node->left, depth + 1, levels);
+    levelsRecursive(node->right, depth + 1, levels);
+}
+
+static void preOrderRecursiveDB(DBNode* node, std::vector<int>& keys) {
+    if (!node) return;
+    keys.insert(keys.end(), node->keys.begin(), node->keys.end());
+    for (DBNode* child : node->children) preOrderRecursiveDB(child, keys);
+}
+
+static void levelsRecursiveDB(DBNode* node, size_t depth, std::vector<std::vector<int>>& levels) {
+    if (!node) return;
+    if (depth == levels.size()) levels.emplace_back();
+    levels[depth].insert(levels[depth].end(), node->keys.begin(), node->keys.end());
+    for (DBNode* child : node->children) levelsRecursiveDB(child, depth + 1, levels);
+}
+
+/**
+ * @brief Совпадают ли три ленивых обхода с рекурсивными
+ */
+static bool traversalsMatch(TreeNode* root) {
+    std::vector<int> preOrder;
+    std::vector<std::vector<int>> levels;
+    preOrderRecursive(root, preOrder);
+    levelsRecursive(root, 0, levels);
+    std::vector<int> levelOrder;
+    for (const std::vector<int>& level : levels) levelOrder.insert(levelOrder.end(), level.begin(), level.end());
+    return collectRange(TreeTraversal::inOrder(root)) == TreeProperties::inOrderTraversal(root) &&
+        collectRange(TreeTraversal::preOrder(root)) == preOrder &&
+        collectRange(TreeTraversal::levelOrder(root)) == levelOrder;
+}
+
+static bool traversalsMatch(DBNode* root) {
+    std::vector<int> inOrder;
+    std::vector<int> preOrder;
+    std::vector<std::vector<int>> levels;
+    TreeBuilders::inOrderTraversalDB(root, inOrder);
+    preOrderRecursiveDB(root, preOrder);
+    levelsRecursiveDB(root, 0, levels);
+    std::vector<int> levelOrder;
+    for (const std::vector<int>& level : levels) levelOrder.insert(levelOrder.end(), level.begin(), level.end());
+    return collectRange(TreeTraversal::inOrder(root)) == inOrder &&
+        collectRange(TreeTraversal::preOrder(root)) == preOrder &&
+        collectRange(TreeTraversal::levelOrder(root)) == levelOrder;
+}
+
+/**
+ * @brief Демонстрация ленивых обходов
+ *
+ * @details
+ * Сравнивает итераторы TreeTraversal с рекурсивными обходами на тестовом,
+ * случайных, вырожденном и пустом деревьях обоих видов и проверяет, что
+ * посетитель, вернувший false, прерывает обход.
+ */
+void Testing::demonstrateTraversal() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ЛЕНИВЫХ ОБХОДОВ ===" << std::endl;
+
+    // Тестовое дерево: 5 (3 (1) (4)) (8 () (9))
+    TreeNode* tree = createTestTree();
+    assert((collectRange(TreeTraversal::inOrder(tree)) == std::vector<int>{ 1, 3, 4, 5, 8, 9 }));
+    assert((collectRange(TreeTraversal::preOrder(tree)) == std::vector<int>{ 5, 3, 1, 4, 8, 9 }));
+    assert((collectRange(TreeTraversal::levelOrder(tree)) == std::vector<int>{ 5, 3, 8, 1, 4, 9 }));
+    assert(traversalsMatch(tree));
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(10000, 1, 100000, 73);
+    std::vector<int> chainKeys(2000);
+    for (int i = 0; i < 2000; i++) chainKeys[i] = i;
+    TreeNode* trees[] = {
+        TreeBuilders::buildRandomSearchTree(data),
+        TreeBuilders::buildAVLTree(data),
+        TreeBuilders::buildRandomSearchTree(chainKeys),  // Цепочка вправо
+    };
+    for (TreeNode* root : trees) assert(traversalsMatch(root));
+    assert(traversalsMatch(static_cast<TreeNode*>(nullptr)));
+    assert(TreeTraversal::inOrder(static_cast<TreeNode*>(nullptr)).begin() == InOrderIterator());
+    std::cout << "+ TreeNode: in/pre/level order совпадают с рекурсивными (тестовое, СДП, АВЛ, цепочка, пустое)" << std::endl;
+
+    DBNode* dbTrees[] = { TreeBuilders::buildDBTree(data, 2), TreeBuilders::buildDBTree(data, 4) };
+    for (DBNode* root : dbTrees) assert(traversalsMatch(root));
+    assert(traversalsMatch(static_cast<DBNode*>(nullptr)));
+    std::cout << "+ DBNode: in/pre/level order совпадают с рекурсивными (t = 2, 4, пустое)" << std::endl;
+
+    // Посетитель, вернувший false, останавливает обход
+    int visited = 0;
+    assert(!TreeTraversal::visitInOrder(trees[1], [&](int) { return ++visited < 5; }));
+    assert(visited == 5);
+    std::vector<int> prefix;
+    assert(!TreeTraversal::visitPreOrder(tree, [&](int key) { prefix.push_back(key); return key != 1; }));
+    assert((prefix == std::vector<int>{ 5, 3, 1 }));
+    visited = 0;
+    assert(!TreeTraversal::visitLevelOrder(dbTrees[0], [&](int) { return ++visited < 3; }));
+    assert(visited == 3);
+    visited = 0;
+    assert(TreeTraversal::visitInOrder(dbTrees[1], [&](int) { visited++; return true; }));
+    assert(visited == static_cast<int>(data.size()));
+    assert(TreeTraversal::visitLevelOrder(static_cast<TreeNode*>(nullptr), [](int) { return false; }));
+    std::cout << "+ Посетитель прерывает обход, полный обход и пустое дерево возвращают true" << std::endl;
+
+    TreeBuilders::deleteTree(tree);
+    for (TreeNode* root : trees) TreeBuilders::deleteTree(root);
+    for (DBNode* root : dbTrees) TreeBuilders::deleteDBTree(root);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация пакетного поиска с чередованием
+ *
+ * @details
+ * Каждый слот результата searchBatch сравнивается с searchNode для
+ * найденных и отсутствующих ключей, повторов, пустого дерева и пакетов
+ * меньше, равных и больше окна поиска.
+ */
+void Testing::demonstrateSearchBatch() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ПАКЕТНОГО ПОИСКА ===" << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(5000, 1, 50000, 91);
+    std::vector<int> chainKeys(500);
+    for (int i = 0; i < 500; i++) chainKeys[i] = i * 2;
+    TreeNode* trees[] = {
+        createTestTree(),
+        TreeBuilders::buildRandomSearchTree(data),
+        TreeBuilders::buildAVLTree(data),
+        TreeBuilders::buildRandomSearchTree(chainKeys),  // Цепочка: поиски сильно разной длины
+    };
+
+    // Смесь найденных и отсутствующих ключей с повторами
+    std::vector<int> probes = DataGenerator::generateRandomNumbers(3000, -10, 50010, 17);
+    for (size_t i = 0; i < 1000; i++) probes.push_back(data[i % data.size()]);
+    for (size_t i = 0; i < 200; i++) probes.push_back(chainKeys[i] + (i % 2));
+    for (int key = 0; key <= 10; key++) probes.push_back(key);
+    for (int i = 0; i < 50; i++) probes.push_back(data[0]);
+
+    const size_t sizes[] = { 0, 1, 5, 15, 16, 17, 100, probes.size() };
+    const int groups[] = { 16, 1, 4, 0 };
+    std::vector<TreeNode*> results;
+    for (TreeNode* root : trees) {
+        for (size_t count : sizes) {
+            std::vector<int> keys(probes.begin(), probes.begin() + count);
+            for (int groupSize : groups) {
+                TreeProperties::searchBatch(root, keys, results, groupSize);
+                assert(results.size() == keys.size());
+                for (size_t i = 0; i < keys.size(); i++) {
+                    assert(results[i] == TreeProperties::searchNode(root, keys[i]));
+                }
+            }
+        }
+    }
+    std::cout << "+ Каждый слот совпадает с searchNode (пакеты 0..." << probes.size()
+        << ", окно 16, 1, 4, 0; тестовое, СДП, АВЛ, цепочка)" << std::endl;
+
+    // Повторы одного ключа в одном окне получают один и тот же узел
+    std::vector<int> repeated(40, data[7]);
+    TreeProperties::searchBatch(trees[2], repeated, results);
+    TreeNode* found = TreeProperties::searchNode(trees[2], data[7]);
+    assert(found != nullptr);
+    for (TreeNode* node : results) assert(node == found);
+
+    // Пустое дерево: все слоты nullptr, размер по пакету; старые результаты стираются
+    results.assign(3, found);
+    TreeProperties::searchBatch(nullptr, probes, results);
+    assert(results.size() == probes.size());
+    for (TreeNode* node : results) assert(node == nullptr);
+    TreeProperties::searchBatch(trees[1], std::vector<int>(), results);
+    assert(results.empty());
+    std::cout << "+ Повторы, пустое дерево и пустой пакет" << std::endl;
+
+    for (TreeNode* root : trees) TreeBuilders::deleteTree(root);
+    std::cout << std::endl;
+}
+
+// Эталонный поиск в ДБД: полный обход всех ключей без спуска по порядку
+static DBNode* findDBRecursive(DBNode* node, int key) {
+    if (!node) return nullptr;
+    if (std::find(node->keys.begin(), node->keys.end(), key) != node->keys.end()) return node;
+    for (DBNode* child : node->children) {
+        DBNode* found = findDBRecursive(child, key);
+        if (found) return found;
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Демонстрация поиска отсортированного пакета
+ *
+ * @details
+ * searchNodeDB сравнивается с полным обходом ДБД, searchSortedBatch и
+ * searchSortedBatchDB - со спусками searchNode и searchNodeDB для каждого
+ * ключа: пакеты с повторами, ключи ниже и выше диапазона, пустой пакет,
+ * пустое дерево и отклонение неотсортированного пакета.
+ */
+void Testing::demonstrateSortedSearch() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ПОИСКА ОТСОРТИРОВАННОГО ПАКЕТА ===" << std::endl;
+
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(5000, 1000, 60000, 29);
+    std::vector<int> chainKeys(500);
+    for (int i = 0; i < 500; i++) chainKeys[i] = 1000 + i * 3;
+    TreeNode* trees[] = {
+        createTestTree(),
+        TreeBuilders::buildRandomSearchTree(data),
+        TreeBuilders::buildAVLTree(data),
+        TreeBuilders::buildRandomSearchTree(chainKeys),
+    };
+    DBNode* dbTrees[] = {
+        TreeBuilders::buildDBTree(data, 2),
+        TreeBuilders::buildDBTree(data, 5),
+        TreeBuilders::buildDBTree(chainKeys, 2),
+    };
+
+    // Ключи ниже и выше диапазона, отсутствующие внутри, найденные и их повторы
+    std::vector<int> probes = DataGenerator::generateRandomNumbers(3000, 0, 61000, 43);
+    for (size_t i = 0; i < 1000; i++) probes.push_back(data[i]);
+    for (size_t i = 0; i < 300; i++) probes.push_back(data[i % 20]);
+    for (int key = -5; key <= 10; key++) probes.push_back(key);
+    for (int key = 0; key < 100; key++) probes.push_back(chainKeys[key] + key % 3);
+    probes.push_back(std::numeric_limits<int>::min());
+    probes.push_back(std::numeric_limits<int>::max());
+    std::sort(probes.begin(), probes.end());
+
+    for (DBNode* root : dbTrees) {
+        for (int key : probes) assert(TreeProperties::searchNodeDB(root, key) == findDBRecursive(root, key));
+    }
+    for (int key : data) assert(TreeProperties::searchNodeDB(dbTrees[0], key) != nullptr);
+    std::cout << "+ searchNodeDB совпадает с полным обходом ДБД (t = 2, 5, цепочка)" << std::endl;
+
+    const size_t sizes[] = { 1, 2, 50, probes.size() };
+    std::vector<TreeNode*> results;
+    std::vector<DBNode*> resultsDB;
+    for (size_t count : sizes) {
+        std::vector<int> keys(probes.end() - count, probes.end());
+        for (TreeNode* root : trees) {
+            TreeProperties::searchSortedBatch(root, keys, results);
+            assert(results.size() == keys.size());
+            for (size_t i = 0; i < keys.size(); i++) assert(results[i] == TreeProperties::searchNode(root, keys[i]));
+        }
+        for (DBNode* root : dbTrees) {
+            TreeProperties::searchSortedBatchDB(root, keys, resultsDB);
+            assert(resultsDB.size() == keys.size());
+            for (size_t i = 0; i < keys.size(); i++) assert(resultsDB[i] == TreeProperties::searchNodeDB(root, keys[i]));
+        }
+    }
+    std::cout << "+ searchSortedBatch / searchSortedBatchDB совпадают с поиском по одному ключу (пакеты 1..."
+        << probes.size() << " с повторами)" << std::endl;
+
+    // Пустое дерево и пустой пакет
+    results.assign(3, trees[0]);
+    TreeProperties::searchSortedBatch(nullptr, probes, results);
+    assert(results.size() == probes.size());
+    for (TreeNode* node : results) assert(node == nullptr);
+    TreeProperties::searchSortedBatchDB(nullptr, probes, resultsDB);
+    assert(resultsDB.size() == probes.size());
+    for (DBNode* node : resultsDB) assert(node == nullptr);
+    assert(TreeProperties::searchNodeDB(nullptr, data[0]) == nullptr);
+    TreeProperties::searchSortedBatch(trees[1], std::vector<int>(), results);
+    TreeProperties::searchSortedBatchDB(dbTrees[0], std::vector<int>(), resultsDB);
+    assert(results.empty() && resultsDB.empty());
+    std::cout << "+ Пустое дерево и пустой пакет" << std::endl;
+
+    // Неотсортированный пакет отклоняется: предупреждение и пустые результаты
+    std::vector<int> unsorted = { data[0], data[1], data[2] };
+    std::sort(unsorted.rbegin(), unsorted.rend());
+    std::ostringstream warnings;
+    std::streambuf* previous = std::cerr.rdbuf(warnings.rdbuf());
+    TreeProperties::searchSortedBatch(trees[2], unsorted, results);
+    TreeProperties::searchSortedBatchDB(dbTrees[0], unsorted, resultsDB);
+    std::cerr.rdbuf(previous);
+    assert(results.size() == unsorted.size() && resultsDB.size() == unsorted.size());
+    for (TreeNode* node : results) assert(node == nullptr);
+    for (DBNode* node : resultsDB) assert(node == nullptr);
+    assert(warnings.str().find("searchSortedBatch ") != std::string::npos);
+    assert(warnings.str().find("searchSortedBatchDB ") != std::string::npos);
+    std::cout << "+ Неотсортированный пакет отклонен с предупреждением" << std::endl;
+
+    for (TreeNode* root : trees) TreeBuilders::deleteTree(root);
+    for (DBNode* root : dbTrees) TreeBuilders::deleteDBTree(root);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация форм входных данных
+ */
+void Testing::demonstrateKeyDistributions() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ФОРМ ВХОДНЫХ ДАННЫХ ===" << std::endl;
+
+    const int count = 2000;
+    const unsigned long long seed = 12345;
+
+    for (KeyDistribution distribution : DataGenerator::buildDistributions()) {
+        std::vector<int> data = DataGenerator::generateKeys(distribution, count, 1, count * 10, seed);
+        assert(data == DataGenerator::generateKeys(distribution, count, 1, count * 10, seed));
+
+        std::vector<int> sortedData = data;
+        std::sort(sortedData.begin(), sortedData.end());
+        assert(std::adjacent_find(sortedData.begin(), sortedData.end()) == sortedData.end());
+        assert(sortedData.front() >= 1 && sortedData.back() <= count * 10);
+        if (distribution == KeyDistribution::Sorted) {
+            assert(data == sortedData);
+        }
+        if (distribution == KeyDistribution::Reverse) {
+            assert(std::equal(data.begin(), data.end(), sortedData.rbegin()));
+        }
+
+        TreeDigest ibDigest, spDigest, avlDigest, dbDigest;
+        TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(sortedData, &ibDigest);
+        TreeNode* spTree = TreeBuilders::buildRandomSearchTree(data, &spDigest);
+        TreeNode* avlTree = TreeBuilders::buildAVLTree(data, &avlDigest);
+        DBNode* dbTree = TreeBuilders::buildDBTree(data, 2, &dbDigest);
+        assert(spDigest == ibDigest && avlDigest == ibDigest && dbDigest == ibDigest);
+
+        std::cout << "+ " << DataGenerator::distributionName(distribution)
+            << ": высота СДП " << TreeProperties::calculateHeight(spTree)
+            << ", АВЛ " << TreeProperties::calculateHeight(avlTree) << std::endl;
+
+        TreeBuilders::deleteTree(ibTree);
+        TreeBuilders::deleteTree(spTree);
+        TreeBuilders::deleteTree(avlTree);
+        TreeBuilders::deleteDBTree(dbTree);
+    }
+
+    // Генераторы со счетчиком: результат не зависит от числа потоков
+    assert(DataGenerator::generateUniqueNumbers(100000, 1, 1000000, seed, 1) ==
+           DataGenerator::generateUniqueNumbers(100000, 1, 1000000, seed, 4));
+    assert(DataGenerator::generateRandomNumbers(100000, 1, 1000, seed, 1) ==
+           DataGenerator::generateRandomNumbers(100000, 1, 1000, seed, 3));
+
+    // Zipf: самый частый ключ встречается примерно в count / H(n) случаях
+    std::vector<int> zipf = DataGenerator::generateKeys(KeyDistribution::Zipf, count, 1, 1000, seed);
+    std::vector<int> sortedZipf = zipf;
+    std::sort(sortedZipf.begin(), sortedZipf.end());
+    int maxFrequency = 0;
+    for (size_t i = 0; i < sortedZipf.size();) {
+        size_t j = i;
+        while (j < sortedZipf.size() && sortedZipf[j] == sortedZipf[i]) j++;
+        maxFrequency = std::max(maxFrequency, static_cast<int>(j - i));
+        i = j;
+    }
+    assert(maxFrequency > count / 20);
+    std::cout << "+ " << DataGenerator::distributionName(KeyDistribution::Zipf)
+        << ": самый частый ключ " << maxFrequency << " раз из " << count << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация потоковых источников ключей
+ */
+void Testing::demonstrateKeySources() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ПОТОКОВЫХ ИСТОЧНИКОВ КЛЮЧЕЙ ===" << std::endl;
+
+    const int count = 100000;
+    const unsigned long long seed = 2024;
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(count, 1, count * 10, seed);
+
+    // Генератор порциями выдает ту же последовательность
+    TreeDigest vectorDigest, streamDigest;
+    TreeNode* avlFromVector = TreeBuilders::buildAVLTree(data, &vectorDigest);
+    GeneratedKeySource generated(count, 1, count * 10, seed);
+    PrefetchingKeySource prefetching(generated);
+    TreeNode* avlFromStream = TreeBuilders::buildAVLTree(prefetching, &streamDigest);
+    assert(vectorDigest == streamDigest);
+    assert(TreeProperties::calculateHeight(avlFromVector) == TreeProperties::calculateHeight(avlFromStream));
+    std::cout << "+ АВЛ из генератора совпадает с АВЛ из вектора" << std::endl;
+
+    // Файл: запись из генератора и построение ДБД при чтении
+    const std::string path = "keys_demo.bin";
+    GeneratedKeySource toFile(count, 1, count * 10, seed);
+    assert(FileKeySource::write(path, toFile) == count);
+    TreeDigest fileDigest;
+    DBNode* dbFromFile = nullptr;
+    {
+        FileKeySource file(path);
+        dbFromFile = TreeBuilders::buildDBTree(file, 2, &fileDigest);
+    }
+    std::remove(path.c_str());
+    assert(fileDigest == vectorDigest);
+    std::cout << "+ ДБД из файла: " << fileDigest.count << " ключей" << std::endl;
+
+    // ИСДП из отсортированного потока той же формы, что и из вектора
+    std::vector<int> sortedData = data;
+    std::sort(sortedData.begin(), sortedData.end());
+    TreeNode* ibFromVector = TreeBuilders::buildPerfectlyBalancedTree(sortedData);
+    VectorKeySource sortedSource(sortedData);
+    TreeNode* ibFromStream = TreeBuilders::buildPerfectlyBalancedTree(sortedSource, count);
+    assert(TreeProperties::inOrderTraversal(ibFromVector) == TreeProperties::inOrderTraversal(ibFromStream));
+    assert(TreeProperties::calculateStats(ibFromVector).levelWidths ==
+           TreeProperties::calculateStats(ibFromStream).levelWidths);
+    std::cout << "+ ИСДП из потока совпадает с ИСДП из вектора" << std::endl;
+
+    TreeBuilders::deleteTree(avlFromVector);
+    TreeBuilders::deleteTree(avlFromStream);
+    TreeBuilders::deleteDBTree(dbFromFile);
+    TreeBuilders::deleteTree(ibFromVector);
+    TreeBuilders::deleteTree(ibFromStream);
+    std::cout << std::endl;
+}
+
+// level каждого узла ДБД равен его глубине
+static bool levelsMatchDepth(DBNode* node, int depth = 0) {
+    if (!node) return true;
+    if (node->level != depth) return false;
+    for (DBNode* child : node->children) {
+        if (!levelsMatchDepth(child, depth + 1)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Демонстрация трасс операций
+ */
+void Testing::demonstrateWorkload() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ТРАСС ОПЕРАЦИЙ ===" << std::endl;
+
+    WorkloadSpec spec;
+    spec.initialKeys = 5000;
+    spec.operationCount = 50000;
+    spec.mix = { 30, 40, 25, 5 };
+    spec.distribution = KeyDistribution::Zipf;
+    spec.seed = 7;
+    Trace trace = Workload::generate(spec);
+    assert(trace.operations.size() == 50000);
+
+    // Сохранение и загрузка без потерь
+    const std::string path = "trace_demo.bin";
+    long long bytes = Workload::save(trace, path);
+    Trace loaded;
+    assert(bytes > 0 && Workload::load(path, loaded));
+    std::remove(path.c_str());
+    assert(loaded.initialKeys == trace.initialKeys);
+    assert(loaded.expected == trace.expected);
+    for (size_t i = 0; i < trace.operations.size(); i++) {
+        assert(loaded.operations[i].type == trace.operations[i].type);
+        assert(loaded.operations[i].key == trace.operations[i].key);
+        assert(loaded.operations[i].length == trace.operations[i].length);
+    }
+    std::cout << "+ Трасса: " << bytes << " байт, "
+        << static_cast<double>(bytes) / trace.operations.size() << " байт на операцию" << std::endl;
+
+    // Все виды деревьев приходят к одному набору ключей и находят одно и то же
+    long long hits = -1;
+    for (TreeKind kind : { TreeKind::PerfectlyBalanced, TreeKind::RandomSearch, TreeKind::AVL, TreeKind::DB }) {
+        ReplayResult result = Workload::replay(loaded, kind);
+        assert(result.digest == trace.expected);
+        assert(hits < 0 || result.hits == hits);
+        hits = result.hits;
+        std::cout << "+ " << Workload::treeKindName(kind) << ": "
+            << static_cast<long long>(result.operationsPerSecond) << " оп/с" << std::endl;
+    }
+
+    // Уровни узлов ДБД остаются глубинами после разделений и удалений
+    std::vector<int> keys = DataGenerator::generateUniqueNumbers(4000, 1, 40000, 11);
+    for (int t : { 2, 3 }) {
+        DBNode* dbTree = TreeBuilders::buildDBTree(keys, t);
+        assert(levelsMatchDepth(dbTree));
+        for (size_t i = 0; i < keys.size(); i += 2) {
+            assert(TreeBuilders::removeDBNode(dbTree, keys[i], t));
+            if (i % 64 == 0) assert(levelsMatchDepth(dbTree));
+        }
+        assert(levelsMatchDepth(dbTree));
+        for (size_t i = 0; i < keys.size(); i += 2) TreeBuilders::insertDBNode(dbTree, keys[i], t);
+        for (size_t i = 1; i < keys.size(); i++) TreeBuilders::removeDBNode(dbTree, keys[i], t);
+        assert(levelsMatchDepth(dbTree));
+        assert(dbTree != nullptr && TreeProperties::searchNodeDB(dbTree, keys[0]) != nullptr);
+        TreeBuilders::removeDBNode(dbTree, keys[0], t);
+        assert(dbTree == nullptr);
+    }
+    std::cout << "+ ДБД: level узлов равен глубине после вставок и удалений" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация счетчиков операций
+ *
+ * @details
+ * Ожидаемые значения посчитаны вручную:
+ * - вставка 1..7 по возрастанию в АВЛ делает 4 одинарных поворота
+ *   (на ключах 3, 5, 6, 7), а перед каждой вставкой спуск проходит
+ *   0, 1, 2, 2, 3, 3, 3 узла - итого 14 узлов и 14 сравнений
+ * - поиск ключа 1 в ИСДП из 1..7 проходит 3 узла
+ * - ИСДП строится без сравнений ключей
+ */
+void Testing::demonstrateOpStats() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ СЧЕТЧИКОВ ОПЕРАЦИЙ ===" << std::endl;
+
+    std::vector<int> ascending = { 1, 2, 3, 4, 5, 6, 7 };
+    OpStats::current().reset();
+    TreeNode* avl = TreeBuilders::buildAVLTree(ascending);
+    OpStats avlOps = OpStats::collect();
+
+    TreeNode* balanced = TreeBuilders::buildPerfectlyBalancedTree(ascending);
+    OpStats balancedOps = OpStats::collect();
+    assert(TreeProperties::searchNode(balanced, 1) != nullptr);
+    OpStats searchOps = OpStats::collect();
+
+    std::vector<int> data = DataGenerator::generateKeys(KeyDistribution::Sorted, 1000, 1, 10000, 5);
+    DBNode* db = TreeBuilders::buildDBTree(data, 2);
+    OpStats dbOps = OpStats::collect();
+
+    // Счетчики другого потока не попадают в счетчики текущего
+    OpStats otherThread;
+    std::thread worker([&]() {
+        TreeNode* tree = TreeBuilders::buildAVLTree(data);
+        otherThread = OpStats::collect();
+        TreeBuilders::deleteTree(tree);
+    });
+    worker.join();
+    OpStats afterWorker = OpStats::collect();
+    assert(afterWorker.comparisons == 0 && afterWorker.nodeVisits == 0);
+
+    if (OpStats::enabled()) {
+        assert(avlOps.rotations == 4);
+        assert(avlOps.nodeVisits == 14 && avlOps.comparisons == 14);
+        assert(balancedOps.comparisons == 0 && balancedOps.rotations == 0);
+        assert(searchOps.nodeVisits == 3 && searchOps.comparisons == 3);
+        assert(dbOps.splits > 0 && dbOps.comparisons > 0);
+        assert(otherThread.rotations > 0);
+        std::cout << "+ АВЛ 1..7: поворотов " << avlOps.rotations
+            << ", узлов " << avlOps.nodeVisits << std::endl;
+        std::cout << "+ ДБД 1000 ключей: разделений " << dbOps.splits
+            << ", сравнений " << dbOps.comparisons << std::endl;
+        std::cout << "+ Поток АВЛ 1000 ключей: поворотов " << otherThread.rotations << std::endl;
+    }
+    else {
+        assert(avlOps.comparisons == 0 && avlOps.rotations == 0 && dbOps.splits == 0);
+        assert(otherThread.nodeVisits == 0);
+        std::cout << "+ Счетчики отключены (сборка без COLLECT_OP_STATS)" << std::endl;
+    }
+
+    TreeBuilders::deleteTree(avl);
+    TreeBuilders::deleteTree(balanced);
+    TreeBuilders::deleteDBTree(db);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация аппаратных счетчиков
+ *
+ * @details
+ * Каждый поиск выполняет хотя бы одну инструкцию на пройденный узел,
+ * поэтому доступный счетчик инструкций обязан превысить число поисков.
+ */
+void Testing::demonstratePerfCounters() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ АППАРАТНЫХ СЧЕТЧИКОВ ===" << std::endl;
+
+    const int size = 10000;
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10, 3);
+    TreeNode* tree = TreeBuilders::buildAVLTree(data);
+
+    PerfCounters counters;
+    int found = 0;
+    PerfReading reading = counters.measure([&]() {
+        for (int key : data) {
+            if (TreeProperties::searchNode(tree, key) != nullptr) found++;
+        }
+    });
+    assert(found == size);
+
+    if (!counters.isAvailable()) {
+        for (int event = 0; event < PERF_EVENT_COUNT; event++) {
+            assert(!reading.available(static_cast<PerfEvent>(event)));
+            assert(reading.perKey(static_cast<PerfEvent>(event), size) < 0);
+        }
+        std::cout << "+ Счетчики недоступны, замер помечен как н/д" << std::endl;
+    }
+    else {
+        if (reading.available(PerfEvent::Instructions)) {
+            assert(reading.values[static_cast<int>(PerfEvent::Instructions)] > size);
+        }
+        for (int event = 0; event < PERF_EVENT_COUNT; event++) {
+            PerfEvent perfEvent = static_cast<PerfEvent>(event);
+            std::cout << "+ " << PerfCounters::eventName(perfEvent) << " на поиск: ";
+            if (reading.available(perfEvent)) std::cout << reading.perKey(perfEvent, size) << std::endl;
+            else std::cout << "н/д" << std::endl;
+        }
+    }
+
+    TreeBuilders::deleteTree(tree);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация учета памяти узлов
+ */
+void Testing::demonstrateNodeMemory() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ УЧЕТА ПАМЯТИ УЗЛОВ ===" << std::endl;
+
+    const int size = 10000;
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10, 11);
+
+    MemoryStats start = NodeMemory::mark();
+    TreeNode* tree = TreeBuilders::buildAVLTree(data);
+    MemoryStats built = NodeMemory::since(start);
+    assert(built.allocations == size);
+    assert(built.liveBytes == static_cast<long long>(size * sizeof(TreeNode)));
+    assert(built.bytesPerKey(size) == sizeof(TreeNode));
+    TreeBuilders::deleteTree(tree);
+    MemoryStats released = NodeMemory::since(start);
+    assert(released.liveBytes == 0 && released.deallocations == size);
+    assert(released.peakBytes == built.liveBytes);
+
+    start = NodeMemory::mark();
+    DBNode* dbTree = TreeBuilders::buildDBTree(data, 2);
+    MemoryStats dbBuilt = NodeMemory::since(start);
+    // Кроме самих узлов учтены массивы: минимум по int на ключ
+    long long dbNodes = 0;
+    std::vector<DBNode*> stack = { dbTree };
+    while (!stack.empty()) {
+        DBNode* node = stack.back();
+        stack.pop_back();
+        dbNodes++;
+        for (DBNode* child : node->children) stack.push_back(child);
+    }
+    assert(dbBuilt.liveBytes >= static_cast<long long>(dbNodes * sizeof(DBNode) + size * sizeof(int)));
+    assert(dbBuilt.peakBytes >= dbBuilt.liveBytes);
+    TreeBuilders::deleteDBTree(dbTree);
+    assert(NodeMemory::since(start).liveBytes == 0);
+
+    std::cout << "+ АВЛ: " << built.bytesPerKey(size) << " байт на ключ (sizeof(TreeNode) = "
+        << sizeof(TreeNode) << ")" << std::endl;
+    std::cout << "+ ДБД: " << dbBuilt.bytesPerKey(size) << " байт на ключ, узлов " << dbNodes
+        << ", выделений " << dbBuilt.allocations << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация отладочного учета утечек
+ */
+void Testing::demonstrateLeakTracker() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ УЧЕТА УТЕЧЕК ===" << std::endl;
+
+    const int threadCount = 4;
+    const int nodesPerThread = 50000;
+    std::vector<std::vector<TreeNode*>> kept(threadCount);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; t++) {
+        workers.emplace_back([&, t]() {
+            std::vector<TreeNode*> nodes;
+            for (int i = 0; i < nodesPerThread; i++) {
+                nodes.push_back(MemoryUtils::createTreeNode(t * nodesPerThread + i));
+                // Часть узлов удаляется сразу - реестр работает на смеси операций
+                if (i % 3 == 0) {
+                    MemoryUtils::deleteTreeNode(nodes.back());
+                    nodes.pop_back();
+                }
+            }
+            // Каждый поток оставляет один узел "утекшим"
+            kept[t].push_back(nodes.back());
+            nodes.pop_back();
+            for (TreeNode* node : nodes) MemoryUtils::deleteTreeNode(node);
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+
+#ifdef DEBUG_MEMORY
+    assert(MemoryUtils::checkMemoryLeaks() == threadCount);
+#else
+    assert(MemoryUtils::checkMemoryLeaks() == 0);
+    std::cout << "+ Реестр отключен (сборка без DEBUG_MEMORY)" << std::endl;
+#endif
+
+    for (std::vector<TreeNode*>& nodes : kept) {
+        for (TreeNode* node : nodes) MemoryUtils::deleteTreeNode(node);
+    }
+    assert(MemoryUtils::checkMemoryLeaks() == 0);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация повторного использования узлов
+ *
+ * @details
+ * Каждый шаг удаляет ключ и вставляет новый, так что число узлов постоянно.
+ * Первый проход прогревает кэш, во втором не должно быть ни одного
+ * выделения из кучи.
+ */
+void Testing::demonstrateNodeRecycling() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ПОВТОРНОГО ИСПОЛЬЗОВАНИЯ УЗЛОВ ===" << std::endl;
+
+    const int size = 10000;
+    const int steps = 50000;
+    std::vector<int> keys = DataGenerator::generateUniqueNumbers(size, 1, size * 10, 17);
+    TreeNode* tree = TreeBuilders::buildAVLTree(keys);
+
+    // Удаляется ключ keys[i % size], вместо него вставляется новый
+    int nextKey = size * 10 + 1;
+    auto churn = [&](int from) {
+        for (int i = from; i < from + steps; i++) {
+            int slot = i % size;
+            TreeDigest digest;
+            tree = TreeBuilders::removeAVL(tree, keys[slot], &digest);
+            assert(digest.count == -1);
+            keys[slot] = nextKey++;
+            tree = TreeBuilders::insertAVL(tree, keys[slot]);
+        }
+    };
+
+    churn(0);
+    MemoryStats start = NodeMemory::mark();
+    churn(steps);
+    MemoryStats steady = NodeMemory::since(start);
+    assert(steady.allocations == steps && steady.deallocations == steps);
+    assert(steady.systemAllocations == 0);
+    assert(steady.liveBytes == 0);
+    std::cout << "+ " << steps << " удалений и вставок: из кучи " << steady.systemAllocations
+        << ", повторно использовано " << steady.recycled << std::endl;
+
+    // Узлы из арены (--huge-pages) переиспользует сама арена, кэш кучи пуст
+    if (HugePageArena::isEnabled()) {
+        TreeBuilders::deleteTree(tree);
+        std::cout << "+ Узлы выделяются из арены на больших страницах" << std::endl << std::endl;
+        return;
+    }
+
+    // Без кэша освобожденные узлы сразу уходят в кучу
+    NodeMemory::trim();
+    assert(NodeMemory::cachedBytes() == 0);
+    NodeMemory::setCacheLimit(0);
+    TreeBuilders::deleteTree(tree);
+    assert(NodeMemory::cachedBytes() == 0);
+    NodeMemory::setCacheLimit(NodeMemory::DEFAULT_CACHE_LIMIT);
+
+    // С кэшем список ограничен пределом, trim возвращает все в кучу
+    tree = TreeBuilders::buildAVLTree(keys);
+    TreeBuilders::deleteTree(tree);
+    long long cached = NodeMemory::cachedBytes();
+    assert(cached > 0 && cached <= static_cast<long long>(NodeMemory::DEFAULT_CACHE_LIMIT) * 256);
+    NodeMemory::trim();
+    assert(NodeMemory::cachedBytes() == 0);
+    std::cout << "+ В кэше после удаления дерева: " << cached / 1024 << " КБ, после trim: 0" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация буферизованного вывода отчетов
+ */
+void Testing::demonstrateOutputSink() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ БУФЕРИЗОВАННОГО ВЫВОДА ===" << std::endl;
+
+    TreeNode* tree = createTestTree();
+    const std::string path = "report_demo.txt";
+    const std::string longLine(100, '*');
+    {
+        // Буфер в 16 байт: и переполнения, и запись блоков длиннее буфера
+        OutputSink sink(path, 16);
+        assert(sink.isOpen());
+        OutputSink::setReport(&sink);
+        OutputUtils::printTreeBracket(tree);
+        OutputSink::report() << longLine << '\n' << 42 << '\n';
+        OutputSink::setReport(nullptr);
+        assert(&OutputSink::report() == &OutputSink::console());
+    }
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    file.close();
+    std::remove(path.c_str());
+    assert(content.str() == "(5 (3 (1) (4)) (8 () (9)))\n" + longLine + "\n42\n");
+    std::cout << "+ Отчет в файле совпадает с ожидаемым: " << content.str().size() << " байт" << std::endl;
+
+    // Вырожденное дерево глубиной 100000: вывод без рекурсии
+    const int chainLength = 100000;
+    TreeNode* chain = nullptr;
+    for (int i = chainLength - 1; i >= 0; i--) {
+        TreeNode* node = new TreeNode(i);
+        node->right = chain;
+        chain = node;
+    }
+    {
+        OutputSink sink(path);
+        OutputSink::setReport(&sink);
+        OutputUtils::printTreeBracket(chain);
+        OutputSink::setReport(nullptr);
+    }
+    std::string expected = "(";
+    for (int i = 0; i < chainLength - 1; i++) expected += std::to_string(i) + " () (";
+    expected += std::to_string(chainLength - 1) + std::string(chainLength, ')') + "\n";
+    file.open(path);
+    content.str("");
+    content << file.rdbuf();
+    file.close();
+    std::remove(path.c_str());
+    assert(content.str() == expected);
+    while (chain != nullptr) {
+        TreeNode* next = chain->right;
+        delete chain;
+        chain = next;
+    }
+    std::cout << "+ Цепочка из " << chainLength << " узлов выведена без переполнения стека" << std::endl;
+
+    OutputSink missing("no_such_directory/report.txt");
+    assert(!missing.isOpen() && missing.bad());
+    std::cout << "+ Недоступный файл: поток в состоянии ошибки" << std::endl;
+
+    TreeBuilders::deleteTree(tree);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Проверка выборки по полному обходу
+ * @param sample Выборка с edge = 5, middle = 5
+ * @param traversal Все ключи дерева по возрастанию
+ */
+static void checkTraversalSample(const TraversalSample& sample, const std::vector<int>& traversal,
+    int edge = 5, int middle = 5) {
+    if (traversal.size() <= static_cast<size_t>(2 * edge + middle)) {
+        assert(sample.complete && sample.first == traversal);
+        return;
+    }
+    assert(!sample.complete);
+    assert(sample.first.size() == static_cast<size_t>(edge) && sample.last.size() == static_cast<size_t>(edge));
+    assert(std::equal(sample.first.begin(), sample.first.end(), traversal.begin()));
+    assert(std::equal(sample.last.begin(), sample.last.end(), traversal.end() - edge));
+
+    // Отметки по значению; каждый ключ середины больше предыдущего и меньше last
+    long long low = traversal.front();
+    long long high = traversal.back();
+    long long next = edge > 0 ? traversal[edge - 1] + 1LL : low;
+    long long ceiling = edge > 0 ? traversal[traversal.size() - edge] : high + 1;
+    std::vector<int> expected;
+    for (int i = 1; i <= middle; i++) {
+        long long target = std::max(low + (high - low) * i / (middle + 1), next);
+        auto key = std::lower_bound(traversal.begin(), traversal.end(), target);
+        if (key == traversal.end() || *key >= ceiling) break;
+        expected.push_back(*key);
+        next = *key + 1LL;
+    }
+    assert(sample.middle == expected);
+    assert(std::adjacent_find(sample.middle.begin(), sample.middle.end(),
+        [](int a, int b) { return a >= b; }) == sample.middle.end());
+}
+
+/**
+ * @brief Демонстрация выборки из обхода
+ */
+void Testing::demonstrateTraversalSample() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ ВЫБОРКИ ИЗ ОБХОДА ===" << std::endl;
+
+    for (int size : { 0, 1, 15, 16, 1000, 100000 }) {
+        std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10 + 1, 31);
+        TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
+        DBNode* dbTree = TreeBuilders::buildDBTree(data, 2);
+        std::vector<int> traversal = TreeProperties::inOrderTraversal(avlTree);
+
+        checkTraversalSample(TreeTraversal::sampleInOrder(avlTree), traversal);
+        checkTraversalSample(TreeTraversal::sampleInOrder(dbTree), traversal);
+
+        TreeBuilders::deleteTree(avlTree);
+        TreeBuilders::deleteDBTree(dbTree);
+    }
+    std::cout << "+ Выборки АВЛ и ДБД совпадают с полным обходом (0..100000 ключей)" << std::endl;
+
+    // Вырожденное дерево: последние ключи на глубине n
+    std::vector<int> sorted(1000);
+    for (int i = 0; i < 1000; i++) sorted[i] = i;
+    TreeNode* chain = TreeBuilders::buildRandomSearchTree(sorted);
+    checkTraversalSample(TreeTraversal::sampleInOrder(chain), sorted);
+    TreeBuilders::deleteTree(chain);
+    std::cout << "+ Выборка из вырожденного СДП совпадает с полным обходом" << std::endl;
+
+    // Сгущенные ключи: 1..100 и 1000000..1000009 - все отметки попадают на верхнее сгущение
+    std::vector<int> skewed;
+    for (int key = 1; key <= 100; key++) skewed.push_back(key);
+    for (int key = 1000000; key <= 1000009; key++) skewed.push_back(key);
+    TreeNode* skewedTree = TreeBuilders::buildAVLTree(skewed);
+    DBNode* skewedDB = TreeBuilders::buildDBTree(skewed, 2);
+    TraversalSample sample = TreeTraversal::sampleInOrder(skewedTree);
+    assert((sample.middle == std::vector<int>{ 1000000, 1000001, 1000002, 1000003, 1000004 }));
+    sample = TreeTraversal::sampleInOrder(skewedTree, 5, 8);
+    assert((sample.middle == std::vector<int>{ 1000000, 1000001, 1000002, 1000003, 1000004 }));
+    for (int edge : { 0, 1, 5, 20 }) {
+        for (int middle : { 0, 1, 5, 8, 30 }) {
+            checkTraversalSample(TreeTraversal::sampleInOrder(skewedTree, edge, middle), skewed, edge, middle);
+            checkTraversalSample(TreeTraversal::sampleInOrder(skewedDB, edge, middle), skewed, edge, middle);
+        }
+    }
+    std::cout << "+ Сгущенные ключи: середина без повторов, между first и last" << std::endl;
+
+    // edge == 0: крайних ключей нет, середина делит весь диапазон
+    sample = TreeTraversal::sampleInOrder(skewedTree, 0, 5);
+    assert(!sample.complete && sample.first.empty() && sample.last.empty());
+    assert((sample.middle == std::vector<int>{ 1000000, 1000001, 1000002, 1000003, 1000004 }));
+    sample = TreeTraversal::sampleInOrder(skewedDB, 0, 0);
+    assert(!sample.complete && sample.first.empty() && sample.middle.empty() && sample.last.empty());
+    std::cout << "+ edge = 0: выборка только из середины" << std::endl;
+
+    TreeBuilders::deleteTree(skewedTree);
+    TreeBuilders::deleteDBTree(skewedDB);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Совпадают ли форма и ключи двух бинарных деревьев
+ * @param compareHeights Сравнивать и поля height (СДП их не поддерживает)
+ */
+static bool sameTree(TreeNode* first, TreeNode* second, bool compareHeights = true) {
+    std::vector<std::pair<TreeNode*, TreeNode*>> stack = { { first, second } };
+    while (!stack.empty()) {
+        TreeNode* a = stack.back().first;
+        TreeNode* b = stack.back().second;
+        stack.pop_back();
+        if (!a || !b) {
+            if (a != b) return false;
+            continue;
+        }
+        if (a->key != b->key || (compareHeights && a->height != b->height)) return false;
+        stack.push_back({ a->left, b->left });
+        stack.push_back({ a->right, b->right });
+    }
+    return true;
+}
+
+/**
+ * @brief Совпадают ли форма и ключи двух ДБД; уровни second - глубины узлов
+ */
+static bool sameDBTree(DBNode* first, DBNode* second, int depth = 0) {
+    if (!first || !second) return first == second;
+    if (first->keys != second->keys || first->isLeaf != second->isLeaf ||
+        first->children.size() != second->children.size() ||
+        first->level != second->level || second->level != depth) {
+        return false;
+    }
+    for (size_t i = 0; i < first->children.size(); i++) {
+        if (!sameDBTree(first->children[i], second->children[i], depth + 1)) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Демонстрация снимков деревьев
+ */
+void Testing::demonstrateTreeSnapshot() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ СНИМКОВ ДЕРЕВЬЕВ ===" << std::endl;
+
+    const int size = 100000;
+    const std::string path = "snapshot_demo.bin";
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10, 47);
+
+    // АВЛ: та же форма и высоты, дерево пригодно для дальнейших вставок
+    TreeDigest avlDigest, loadedDigest;
+    TreeNode* avlTree = TreeBuilders::buildAVLTree(data, &avlDigest);
+    long long bytes = TreeSnapshot::save(avlTree, path);
+    assert(bytes > 0);
+    TreeNode* loaded = nullptr;
+    assert(TreeSnapshot::load(path, loaded, &loadedDigest));
+    assert(loadedDigest == avlDigest);
+    assert(sameTree(avlTree, loaded));
+    loaded = TreeBuilders::insertAVL(loaded, size * 10 + 1);
+    assert(TreeProperties::calculateHeight(loaded) == loaded->height);
+    std::cout << "+ АВЛ из " << size << " ключей: " << bytes << " байт ("
+        << static_cast<double>(bytes) / size << " на ключ), форма и высоты совпадают" << std::endl;
+    TreeBuilders::deleteTree(avlTree);
+    TreeBuilders::deleteTree(loaded);
+
+    // Вырожденное СДП: сохранение и загрузка без рекурсии по глубине
+    std::vector<int> sorted(10000);
+    for (int i = 0; i < 10000; i++) sorted[i] = i;
+    TreeNode* chain = TreeBuilders::buildRandomSearchTree(sorted);
+    assert(TreeSnapshot::save(chain, path) > 0);
+    assert(TreeSnapshot::load(path, loaded));
+    assert(sameTree(chain, loaded, false) && loaded->height == 10000);
+    TreeBuilders::deleteTree(chain);
+    TreeBuilders::deleteTree(loaded);
+    std::cout << "+ Вырожденное СДП высоты 10000 восстановлено" << std::endl;
+
+    // ДБД: та же форма, степень t из снимка, уровни - глубины узлов
+    TreeDigest dbDigest;
+    loadedDigest = TreeDigest();
+    DBNode* dbTree = TreeBuilders::buildDBTree(data, 3, &dbDigest);
+    assert(TreeSnapshot::save(dbTree, 3, path) > 0);
+    DBNode* loadedDB = nullptr;
+    int t = 0;
+    assert(TreeSnapshot::load(path, loadedDB, t, &loadedDigest));
+    assert(t == 3 && loadedDigest == dbDigest);
+    assert(sameDBTree(dbTree, loadedDB));
+    TreeBuilders::deleteDBTree(loadedDB);
+
+    // После удалений level остается глубиной, поэтому загрузка его не меняет
+    for (size_t i = 0; i < data.size(); i += 3) TreeBuilders::removeDBNode(dbTree, data[i], 3);
+    assert(TreeSnapshot::save(dbTree, 3, path) > 0);
+    assert(TreeSnapshot::load(path, loadedDB, t));
+    assert(sameDBTree(dbTree, loadedDB));
+    TreeBuilders::deleteDBTree(loadedDB);
+
+    // level, не равный глубине, в файл не попадает: при загрузке он нормализуется
+    DBNode* child = dbTree->children[0];
+    child->level += 5;
+    assert(TreeSnapshot::save(dbTree, 3, path) > 0);
+    assert(TreeSnapshot::load(path, loadedDB, t));
+    assert(loadedDB->children[0]->level == 1 && !sameDBTree(dbTree, loadedDB));
+    child->level -= 5;
+    assert(sameDBTree(dbTree, loadedDB));
+    TreeBuilders::deleteDBTree(loadedDB);
+    std::cout << "+ ДБД (t = 3): форма, ключи и уровни совпадают, в том числе после удалений" << std::endl;
+
+    // Снимок другого вида и обрезанный снимок отвергаются
+    assert(!TreeSnapshot::load(path, loaded) && loaded == nullptr);
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    assert(file);
+    std::fseek(file, 0, SEEK_END);
+    long fileSize = std::ftell(file);
+    std::fclose(file);
+    std::vector<char> truncated(static_cast<size_t>(fileSize) - 1);
+    file = std::fopen(path.c_str(), "rb");
+    assert(std::fread(truncated.data(), 1, truncated.size(), file) == truncated.size());
+    std::fclose(file);
+    file = std::fopen(path.c_str(), "wb");
+    std::fwrite(truncated.data(), 1, truncated.size(), file);
+    std::fclose(file);
+    assert(!TreeSnapshot::load(path, loadedDB, t) && loadedDB == nullptr);
+    std::remove(path.c_str());
+    std::cout << "+ Снимок другого вида и обрезанный снимок отвергнуты" << std::endl;
+
+    // Пустое дерево
+    assert(TreeSnapshot::save(static_cast<TreeNode*>(nullptr), path) > 0);
+    assert(TreeSnapshot::load(path, loaded) && loaded == nullptr);
+    std::remove(path.c_str());
+
+    TreeBuilders::deleteDBTree(dbTree);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Совпадает ли компактное дерево с деревом из указателей
+ */
+static bool sameAsSuccinct(TreeNode* root, const SuccinctTree& succinct) {
+    std::vector<std::pair<TreeNode*, long long>> stack = { { root, succinct.root() } };
+    while (!stack.empty()) {
+        TreeNode* node = stack.back().first;
+        long long index = stack.back().second;
+        stack.pop_back();
+        if (!node || index == SuccinctTree::NONE) {
+            if (node || index != SuccinctTree::NONE) return false;
+            continue;
+        }
+        if (node->key != succinct.key(index)) return false;
+        stack.push_back({ node->left, succinct.left(index) });
+        stack.push_back({ node->right, succinct.right(index) });
+    }
+    return true;
+}
+
+/**
+ * @brief Демонстрация компактного представления дерева
+ */
+void Testing::demonstrateSuccinctTree() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ КОМПАКТНОГО ПРЕДСТАВЛЕНИЯ ===" << std::endl;
+
+    const int size = 100000;
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, -size * 5, size * 5, 53);
+    MemoryStats start = NodeMemory::mark();
+    TreeNode* avlTree = TreeBuilders::buildAVLTree(data);
+    MemoryStats pointerMemory = NodeMemory::since(start);
+    SuccinctTree succinct(avlTree);
+
+    assert(succinct.size() == static_cast<size_t>(size));
+    assert(succinct.height() == TreeProperties::calculateHeight(avlTree));
+    assert(sameAsSuccinct(avlTree, succinct));
+    for (int key : data) {
+        long long index = succinct.search(key);
+        assert(index != SuccinctTree::NONE && succinct.key(index) == key);
+    }
+    for (int key = -size * 5 - 10; key < -size * 5 + 1000; key++) {
+        assert((succinct.search(key) != SuccinctTree::NONE) == (TreeProperties::searchNode(avlTree, key) != nullptr));
+    }
+    std::cout << "+ АВЛ из " << size << " ключей: " << pointerMemory.bytesPerKey(size) << " байт/ключ в узлах, "
+        << static_cast<double>(succinct.memoryBytes()) / size << " в компактном виде ("
+        << succinct.keyBits() << " бит на ключ)" << std::endl;
+    TreeBuilders::deleteTree(avlTree);
+
+    // Вырожденное СДП и пустое дерево
+    std::vector<int> sorted(5000);
+    for (int i = 0; i < 5000; i++) sorted[i] = i * 3;
+    TreeNode* chain = TreeBuilders::buildRandomSearchTree(sorted);
+    SuccinctTree succinctChain(chain);
+    assert(succinctChain.height() == 5000 && sameAsSuccinct(chain, succinctChain));
+    assert(succinctChain.search(4998 * 3) != SuccinctTree::NONE && succinctChain.search(1) == SuccinctTree::NONE);
+    TreeBuilders::deleteTree(chain);
+
+    SuccinctTree empty(nullptr);
+    assert(empty.size() == 0 && empty.root() == SuccinctTree::NONE && empty.search(0) == SuccinctTree::NONE);
+    std::cout << "+ Вырожденное СДП и пустое дерево" << std::endl;
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация статического индекса в файле
+ */
+void Testing::demonstrateStaticIndex() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ СТАТИЧЕСКОГО ИНДЕКСА ===" << std::endl;
+
+    const int size = 100000;
+    const std::string path = "index_demo.bin";
+    std::vector<int> data = DataGenerator::generateUniqueNumbers(size, 1, size * 10, 59);
+    std::sort(data.begin(), data.end());
+    TreeNode* ibTree = TreeBuilders::buildPerfectlyBalancedTree(data);
+
+    // Индекс по дереву и по вектору ключей - один и тот же файл
+    long long bytes = StaticIndex::write(ibTree, path);
+    assert(bytes == 64 + static_cast<long long>(size + 1) * 4);
+    StaticIndex index;
+    assert(index.open(path) && index.size() == static_cast<size_t>(size));
+    for (int key = 0; key <= size * 10 + 1; key++) {
+        const int* found = index.search(key);
+        TreeNode* node = TreeProperties::searchNode(ibTree, key);
+        assert((found != nullptr) == (node != nullptr));
+        assert(!found || *found == key);
+    }
+    std::cout << "+ Поиск по индексу совпадает с searchNode для ключей 0.." << size * 10 + 1
+        << (index.isMapped() ? " (файл отображен в память)" : " (файл прочитан в память)") << std::endl;
+
+    // Второй экземпляр открывает тот же файл одновременно с первым
+    StaticIndex second;
+    assert(second.open(path) && second.contains(data.front()) && second.contains(data.back()));
+    second.close();
+    assert(!second.isOpen() && !second.contains(data.front()));
+    index.close();
+
+    assert(StaticIndex::write(data, path) == bytes);
+    assert(index.open(path) && index.contains(data[size / 2]));
+    index.close();
+
+    // Неотсортированные ключи, чужой и поврежденный файлы отвергаются
+    assert(StaticIndex::write(std::vector<int>{ 3, 1, 2 }, path) == -1);
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fputs("not an index", file);
+    std::fclose(file);
+    assert(!index.open(path) && !index.isOpen());
+    StaticIndex::write(std::vector<int>{ 1, 2, 3 }, path);
+    file = std::fopen(path.c_str(), "ab");
+    std::fputc(0, file);
+    std::fclose(file);
+    assert(!index.open(path));
+    std::remove(path.c_str());
+
+    // Пустой индекс
+    assert(StaticIndex::write(std::vector<int>(), path) == 68);
+    assert(index.open(path) && index.size() == 0 && !index.contains(0));
+    index.close();
+    std::remove(path.c_str());
+    std::cout << "+ Неотсортированные ключи, чужой и поврежденный файлы отвергнуты" << std::endl;
+
+    TreeBuilders::deleteTree(ibTree);
+    std::cout << std::endl;
+}
+
+/**
+ * @brief Демонстрация конкурентного АВЛ-дерева
+ */
+void Testing::demonstrateConcurrentAVL() {
+    std::cout << "=== ДЕМОНСТРАЦИЯ КОНКУРЕНТНОГО АВЛ-ДЕРЕВА ===" << std::endl;
+
+    // В одном потоке - те же повороты, что у insertAVL
+    std::vector<int> data = DataGenerator::generateRandomNumbers(20000, 1, 10000, 61);
+    TreeNode* avlTree = nullptr;
+    {
+        ConcurrentAVL tree;
+        for (int key : data) {
+            bool added = tree.insert(key);
+            assert(added != (TreeProperties::searchNode(avlTree, key) != nullptr));
+            avlTree = TreeBuilders::insertAVL(avlTree, key);
+        }
+        std::vector<int> keys = tree.keys();
+        assert(keys == TreeProperties::inOrderTraversal(avlTree));
+        assert(tree.isValid() && tree.height() == TreeProperties::calculateHeight(avlTree));
+        for (int key = 0; key <= 10001; key++) {
+            assert(tree.contains(key) == (TreeProperties::searchNode(avlTree, key) != nullptr));
+        }
+        for (size_t i = 0; i < keys.size(); i += 2) assert(tree.remove(keys[i]) && !tree.contains(keys[i]));
+        assert(!tree.remove(keys[0]) && tree.isValid());
+        assert(tree.size() == static_cast<long long>(keys.size() / 2));
+        std::cout << "+ Один поток: ключи и высота (" << TreeProperties::calculateHeight(avlTree)
+            << ") совпадают с insertAVL, удаление сохраняет условие АВЛ" << std::endl;
+    }
+    TreeBuilders::deleteTree(avlTree);
+
+    // Потоки вставляют и удаляют свои ключи, пока читатели ищут общие
+    const int threadCount = 4;
+    const int keysPerThread = 5000;
+    ConcurrentAVL tree;
+    for (int key = 0; key < keysPerThread; key++) tree.insert(key * (threadCount + 1));
+
+    std::vector<std::thread> workers;
+    std::vector<int> failures(threadCount * 2, 0);
+    for (int thread = 0; thread < threadCount; thread++) {
+        workers.emplace_back([&, thread]() {
+            for (int i = 0; i < keysPerThread; i++) {
+                int key = i * (threadCount + 1) + thread + 1;
+                if (!tree.insert(key) || !tree.contains(key)) failures[thread]++;
+            }
+            for (int i = 0; i < keysPerThread; i += 2) {
+                int key = i * (threadCount + 1) + thread + 1;
+                if (!tree.remove(key) || tree.contains(key)) failures[thread]++;
+            }
+        });
+        workers.emplace_back([&, thread]() {
+            for (int round = 0; round < 4; round++) {
+                for (int key = thread; key < keysPerThread; key += threadCount) {
+                    if (!tree.contains(key * (threadCount + 1))) failures[threadCount + thread]++;
+                }
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    assert(std::count(failures.begin(), failures.end(), 0) == threadCount * 2);
+
+    std::vector<int> expected;
+    for (int i = 0; i < keysPerThread; i++) {
+        expected.push_back(i * (threadCount + 1));
+        for (int thread = 0; thread < threadCount; thread++) {
+            if (i % 2 == 1) expected.push_back(i * (threadCount + 1) + thread + 1);
+        }
+    }
+    assert(tree.keys() == expected && tree.isValid());
+    std::cout << "+ " << threadCount << " пишущих и " << threadCount << " читающих потока: "
+        << tree.size() << " ключей, высота " << tree.height()
+        << ", читатели видели все постоянные ключи" << std::endl;
+
+    // Исключенные узлы освобождаются после выхода всех потоков из секций
+    EpochReclamation::reclaimAll();
+    assert(EpochReclamation::pending() == 0);
+    std::cout << "+ Исключенные узлы освобождены, эпоха " << EpochReclamation::epoch() << std::endl;
+    std::cout << std::endl;
+}
+
 /**
  * @brief Создание тестового дерева для демонстрации
  *
@@ -50,6 +50,183 @@ public:
      */
     static void demonstrateDBTree();
 
+    /**
+     * @brief   DSW
+     *
+     *         
+     *  .  ,     BST.
+     */
+    static void demonstrateDSWRebalance();
+
+    /**
+     * @brief    
+     *
+     *   ParallelProperties  
+     *  TreeProperties   .
+     */
+    static void demonstrateParallelProperties();
+
+    /**
+     * @brief      
+     *
+     *   TreeStats    calculate*
+     *        .
+     */
+    static void demonstrateTreeStats();
+
+    /**
+     * @brief   
+     *
+     *  ,   ,  
+     *       .
+     */
+    static void demonstrateTreeDigest();
+
+    /**
+     * @brief   
+     *
+     *   TreeTraversal    
+     * TreeNode  DBNode     .
+     */
+    static void demonstrateTraversal();
+
+    /**
+     * @brief     
+     *
+     *    searchBatch  searchNode  
+     *  , ,     .
+     */
+    static void demonstrateSearchBatch();
+
+    /**
+     * @brief    
+     *
+     *  searchSortedBatch  searchSortedBatchDB    
+     * ,  searchNodeDB -    ;   
+     *    .
+     */
+    static void demonstrateSortedSearch();
+
+    /**
+     * @brief    
+     *
+     *      , , 
+     *    seed;  ,     
+     *  .  Zipf   .
+     */
+    static void demonstrateKeyDistributions();
+
+    /**
+     * @brief    
+     *
+     *    ,     
+     *         .
+     */
+    static void demonstrateKeySources();
+
+    /**
+     * @brief   
+     *
+     *      ,    ,
+     *         
+     *  . ,  level     
+     * .
+     */
+    static void demonstrateWorkload();
+
+    /**
+     * @brief   
+     *
+     *         
+     *       .   
+     * COLLECT_OP_STATS ,    .
+     */
+    static void demonstrateOpStats();
+
+    /**
+     * @brief   
+     *
+     *    -  PerfCounters.  
+     * , ,      .
+     */
+    static void demonstratePerfCounters();
+
+    /**
+     * @brief    
+     *
+     *     -   TreeNode, ,   
+     *     ,     
+     *     .
+     */
+    static void demonstrateNodeMemory();
+
+    /**
+     * @brief    
+     *
+     *         MemoryUtils;
+     *    DEBUG_MEMORY ,    
+     *   .
+     */
+    static void demonstrateLeakTracker();
+
+    /**
+     * @brief    
+     *
+     *      -  ,  
+     *         ,  
+     *     .
+     */
+    static void demonstrateNodeRecycling();
+
+    /**
+     * @brief    
+     *
+     *   OutputUtils    OutputSink  
+     *   ,         .
+     */
+    static void demonstrateOutputSink();
+
+    /**
+     * @brief        
+     *
+     *  TreeTraversal::sampleInOrder  -  
+     *   in-order .
+     */
+    static void demonstrateTraversalSample();
+
+    /**
+     * @brief   
+     *
+     *  -,    ,    ,
+     *  ,    ,    .
+     */
+    static void demonstrateTreeSnapshot();
+
+    /**
+     * @brief    
+     *
+     *  SuccinctTree  -     ,
+     *           .
+     */
+    static void demonstrateSuccinctTree();
+
+    /**
+     * @brief     
+     *
+     *     ,    
+     *       TreeProperties::searchNode.
+     */
+    static void demonstrateStaticIndex();
+
+    /**
+     * @brief   -
+     *
+     *  ConcurrentAVL  insertAVL   ,  
+     *         
+     *    ,    .
+     */
+    static void demonstrateConcurrentAVL();
+
 private:
     /**
      * @brief     
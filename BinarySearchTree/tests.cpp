@@ -17,6 +17,27 @@ void runTests() {
     Testing::demonstrateRandomTree();
     Testing::demonstrateAVLTree();
     Testing::demonstrateDBTree();
+    Testing::demonstrateDSWRebalance();
+    Testing::demonstrateParallelProperties();
+    Testing::demonstrateTreeStats();
+    Testing::demonstrateTreeDigest();
+    Testing::demonstrateTraversal();
+    Testing::demonstrateSearchBatch();
+    Testing::demonstrateSortedSearch();
+    Testing::demonstrateKeyDistributions();
+    Testing::demonstrateKeySources();
+    Testing::demonstrateWorkload();
+    Testing::demonstrateOpStats();
+    Testing::demonstratePerfCounters();
+    Testing::demonstrateNodeMemory();
+    Testing::demonstrateLeakTracker();
+    Testing::demonstrateNodeRecycling();
+    Testing::demonstrateOutputSink();
+    Testing::demonstrateTraversalSample();
+    Testing::demonstrateTreeSnapshot();
+    Testing::demonstrateSuccinctTree();
+    Testing::demonstrateStaticIndex();
+    Testing::demonstrateConcurrentAVL();
 
     std::cout << "===   ===" << std::endl << std::endl;
 }
\ No newline at end of file
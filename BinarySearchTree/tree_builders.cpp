@@ -4,15 +4,19 @@
  */
 
 #include "tree_builders.h"
+#include "key_source.h"
+#include "op_stats.h"
 #include <algorithm>
 #include <iostream>
 #include <climits>
+#include <cmath>
 
  // ================== ИСДП ==================
 
  /**
   * @brief Построение Идеально Сбалансированного Дерева Поиска (ИСДП)
   * @param sortedData Отсортированный массив уникальных чисел
+  * @param digest Дайджест содержимого (необязательно)
   * @return Указатель на корень построенного ИСДП
   *
   * @details
@@ -23,7 +27,7 @@
   * @note Требует отсортированного массива на входе.
   * @warning Проверяет отсортированность массива, выводит предупреждение если не отсортирован.
   */
-TreeNode* TreeBuilders::buildPerfectlyBalancedTree(const std::vector<int>& sortedData) {
+TreeNode* TreeBuilders::buildPerfectlyBalancedTree(const std::vector<int>& sortedData, TreeDigest* digest) {
     if (sortedData.empty()) return nullptr;
 
     // Проверка отсортированности массива (опционально, для отладки)
@@ -31,6 +35,10 @@ TreeNode* TreeBuilders::buildPerfectlyBalancedTree(const std::vector<int>& sorte
         std::cerr << "Предупреждение: массив для ИСДП не отсортирован!" << std::endl;
     }
 
+    if (digest) {
+        for (int key : sortedData) digest->add(key);
+    }
+
     return buildBalancedTreeRecursive(sortedData, 0, sortedData.size() - 1);
 }
 
@@ -62,11 +70,55 @@ TreeNode* TreeBuilders::buildBalancedTreeRecursive(const std::vector<int>& sorte
     return root;
 }
 
+/**
+ * @brief Построение ИСДП из потока отсортированных ключей
+ *
+ * @details
+ * Размеры поддеревьев те же, что в buildBalancedTreeRecursive: левое
+ * получает (count - 1) / 2 ключей. Поддеревья строятся в порядке in-order,
+ * поэтому ключи берутся из источника строго по очереди.
+ */
+TreeNode* TreeBuilders::buildPerfectlyBalancedTree(KeySource& sortedSource, int count, TreeDigest* digest) {
+    KeyReader reader(sortedSource);
+    TreeNode* root = buildBalancedTreeFromStream(reader, count, digest);
+
+    if (!reader.isAscending()) {
+        std::cerr << "Предупреждение: поток для ИСДП не отсортирован!" << std::endl;
+    }
+    return root;
+}
+
+/**
+ * @brief Рекурсивное построение ИСДП из потока
+ *
+ * @note Если источник закончился раньше count ключей, выводится
+ *       предупреждение и возвращается уже построенная часть.
+ */
+TreeNode* TreeBuilders::buildBalancedTreeFromStream(KeyReader& reader, int count, TreeDigest* digest) {
+    if (count <= 0) return nullptr;
+
+    int leftCount = (count - 1) / 2;
+    TreeNode* left = buildBalancedTreeFromStream(reader, leftCount, digest);
+
+    int key;
+    if (!reader.next(key)) {
+        std::cerr << "Предупреждение: в потоке для ИСДП меньше ключей, чем заявлено!" << std::endl;
+        return left;
+    }
+    if (digest) digest->add(key);
+
+    TreeNode* root = new TreeNode(key);
+    root->left = left;
+    root->right = buildBalancedTreeFromStream(reader, count - 1 - leftCount, digest);
+    return root;
+}
+
 // ================== СДП ==================
 
 /**
  * @brief Построение Случайного Дерева Поиска (СДП)
  * @param data Массив чисел (не обязательно отсортированный)
+ * @param digest Дайджест содержимого (необязательно)
  * @return Указатель на корень построенного СДП
  *
  * @details
@@ -76,9 +128,23 @@ TreeNode* TreeBuilders::buildBalancedTreeRecursive(const std::vector<int>& sorte
  * @note Для случайных данных ожидаемая высота ~2.99*log₂(n)
  * @note Для отсортированных данных вырождается в список высотой n
  */
-TreeNode* TreeBuilders::buildRandomSearchTree(const std::vector<int>& data) {
+TreeNode* TreeBuilders::buildRandomSearchTree(const std::vector<int>& data, TreeDigest* digest) {
+    TreeNode* root = nullptr;
+    for (int key : data) insertNode(root, key, digest);
+    return root;
+}
+
+/**
+ * @brief Построение СДП из потока ключей
+ *
+ * Ключи вставляются порциями по мере чтения, в памяти одна порция.
+ */
+TreeNode* TreeBuilders::buildRandomSearchTree(KeySource& source, TreeDigest* digest) {
     TreeNode* root = nullptr;
-    for (int key : data) insertNode(root, key);
+    std::vector<int> chunk;
+    while (source.nextChunk(chunk, KeySource::DEFAULT_CHUNK_SIZE)) {
+        for (int key : chunk) insertNode(root, key, digest);
+    }
     return root;
 }
 
@@ -86,6 +152,7 @@ TreeNode* TreeBuilders::buildRandomSearchTree(const std::vector<int>& data) {
  * @brief Вставка узла в BST
  * @param root Корень дерева (передается по ссылке)
  * @param key Ключ для вставки
+ * @param digest Дайджест содержимого (обновляется только при создании узла)
  *
  * @details
  * Вставляет новый узел в бинарное дерево поиска, сохраняя свойство BST:
@@ -94,22 +161,72 @@ TreeNode* TreeBuilders::buildRandomSearchTree(const std::vector<int>& data) {
  *
  * @note Рекурсивная реализация
  */
-void TreeBuilders::insertNode(TreeNode*& root, int key) {
+void TreeBuilders::insertNode(TreeNode*& root, int key, TreeDigest* digest) {
     if (!root) {
         root = new TreeNode(key);
+        if (digest) digest->add(key);
         return;
     }
 
-    if (key < root->key) insertNode(root->left, key);
-    else if (key > root->key) insertNode(root->right, key);
+    OP_STATS_ADD(nodeVisits, 1);
+    OP_STATS_ADD(comparisons, 1);
+    if (key < root->key) insertNode(root->left, key, digest);
+    else if (key > root->key) insertNode(root->right, key, digest);
     // Игнорируем дубликаты (по условию все ключи уникальны)
 }
 
+/**
+ * @brief Вставка ключа в дерево поиска без балансировки
+ */
+void TreeBuilders::insertBST(TreeNode*& root, int key, TreeDigest* digest) {
+    TreeNode** link = &root;
+    while (*link) {
+        if (key < (*link)->key) link = &(*link)->left;
+        else if (key > (*link)->key) link = &(*link)->right;
+        else return; // дубликат
+    }
+    *link = new TreeNode(key);
+    if (digest) digest->add(key);
+}
+
+/**
+ * @brief Удаление ключа из дерева поиска без балансировки
+ *
+ * @details
+ * link указывает на поле родителя, хранящее удаляемый узел, поэтому
+ * замена узла потомком не требует отдельного случая для корня.
+ */
+bool TreeBuilders::removeBST(TreeNode*& root, int key, TreeDigest* digest) {
+    TreeNode** link = &root;
+    while (*link && (*link)->key != key) {
+        link = key < (*link)->key ? &(*link)->left : &(*link)->right;
+    }
+    TreeNode* node = *link;
+    if (!node) return false;
+    if (digest) digest->remove(key);
+
+    if (node->left && node->right) {
+        // Преемник - минимум правого поддерева, левого потомка у него нет
+        TreeNode** successorLink = &node->right;
+        while ((*successorLink)->left) successorLink = &(*successorLink)->left;
+        TreeNode* successor = *successorLink;
+        node->key = successor->key;
+        *successorLink = successor->right;
+        delete successor;
+    }
+    else {
+        *link = node->left ? node->left : node->right;
+        delete node;
+    }
+    return true;
+}
+
 // ================== АВЛ ==================
 
 /**
  * @brief Построение АВЛ-дерева
  * @param data Массив уникальных чисел
+ * @param digest Дайджест содержимого (необязательно)
  * @return Указатель на корень АВЛ-дерева
  *
  * @details
@@ -119,9 +236,21 @@ void TreeBuilders::insertNode(TreeNode*& root, int key) {
  *
  * @note Выполняет балансировку после каждой вставки
  */
-TreeNode* TreeBuilders::buildAVLTree(const std::vector<int>& data) {
+TreeNode* TreeBuilders::buildAVLTree(const std::vector<int>& data, TreeDigest* digest) {
     TreeNode* root = nullptr;
-    for (int key : data) root = insertAVL(root, key);
+    for (int key : data) root = insertAVL(root, key, digest);
+    return root;
+}
+
+/**
+ * @brief Построение АВЛ-дерева из потока ключей
+ */
+TreeNode* TreeBuilders::buildAVLTree(KeySource& source, TreeDigest* digest) {
+    TreeNode* root = nullptr;
+    std::vector<int> chunk;
+    while (source.nextChunk(chunk, KeySource::DEFAULT_CHUNK_SIZE)) {
+        for (int key : chunk) root = insertAVL(root, key, digest);
+    }
     return root;
 }
 
@@ -129,6 +258,7 @@ TreeNode* TreeBuilders::buildAVLTree(const std::vector<int>& data) {
  * @brief Вставка узла в АВЛ-дерево с балансировкой
  * @param node Указатель на текущий узел
  * @param key Ключ для вставки
+ * @param digest Дайджест содержимого (обновляется только при создании узла)
  * @return Новый корень поддерева после вставки и балансировки
  *
  * @details
@@ -140,11 +270,16 @@ TreeNode* TreeBuilders::buildAVLTree(const std::vector<int>& data) {
  *
  * @note Баланс-фактор = высота(левое_поддерево) - высота(правое_поддерево)
  */
-TreeNode* TreeBuilders::insertAVL(TreeNode* node, int key) {
-    if (!node) return new TreeNode(key);
+TreeNode* TreeBuilders::insertAVL(TreeNode* node, int key, TreeDigest* digest) {
+    if (!node) {
+        if (digest) digest->add(key);
+        return new TreeNode(key);
+    }
 
-    if (key < node->key) node->left = insertAVL(node->left, key);
-    else if (key > node->key) node->right = insertAVL(node->right, key);
+    OP_STATS_ADD(nodeVisits, 1);
+    OP_STATS_ADD(comparisons, 1);
+    if (key < node->key) node->left = insertAVL(node->left, key, digest);
+    else if (key > node->key) node->right = insertAVL(node->right, key, digest);
     else return node; // уникальные ключи
 
     // Обновление высоты узла
@@ -173,6 +308,61 @@ TreeNode* TreeBuilders::insertAVL(TreeNode* node, int key) {
     return node;
 }
 
+/**
+ * @brief Удаление ключа из АВЛ-дерева с балансировкой
+ *
+ * @details
+ * Удаление как в дереве поиска (узел с двумя потомками получает ключ
+ * преемника), затем на обратном пути рекурсии обновляются высоты
+ * и восстанавливается баланс.
+ */
+TreeNode* TreeBuilders::removeAVL(TreeNode* node, int key, TreeDigest* digest) {
+    if (!node) return nullptr;
+
+    if (key < node->key) {
+        node->left = removeAVL(node->left, key, digest);
+    }
+    else if (key > node->key) {
+        node->right = removeAVL(node->right, key, digest);
+    }
+    else {
+        if (digest) digest->remove(key);
+
+        if (!node->left || !node->right) {
+            TreeNode* child = node->left ? node->left : node->right;
+            delete node;
+            return child;
+        }
+
+        TreeNode* successor = node->right;
+        while (successor->left) successor = successor->left;
+        node->key = successor->key;
+        node->right = removeAVL(node->right, successor->key, nullptr);
+    }
+
+    return rebalanceAVL(node);
+}
+
+/**
+ * @brief Восстановление баланса узла после удаления
+ */
+TreeNode* TreeBuilders::rebalanceAVL(TreeNode* node) {
+    node->height = 1 + std::max(getHeight(node->left), getHeight(node->right));
+    int balance = getBalance(node);
+
+    if (balance > 1) {
+        // Левый Правый случай сводится к Левому Левому
+        if (getBalance(node->left) < 0) node->left = rotateLeft(node->left);
+        return rotateRight(node);
+    }
+    if (balance < -1) {
+        // Правый Левый случай сводится к Правому Правому
+        if (getBalance(node->right) > 0) node->right = rotateRight(node->right);
+        return rotateLeft(node);
+    }
+    return node;
+}
+
 /**
  * @brief Получение высоты узла
  * @param node Указатель на узел
@@ -210,6 +400,7 @@ int TreeBuilders::getBalance(TreeNode* node) {
  *          z
  */
 TreeNode* TreeBuilders::rotateLeft(TreeNode* x) {
+    OP_STATS_ADD(rotations, 1);
     TreeNode* y = x->right;
     TreeNode* T2 = y->left;
 
@@ -237,6 +428,7 @@ TreeNode* TreeBuilders::rotateLeft(TreeNode* x) {
  *    z
  */
 TreeNode* TreeBuilders::rotateRight(TreeNode* y) {
+    OP_STATS_ADD(rotations, 1);
     TreeNode* x = y->left;
     TreeNode* T2 = x->right;
 
@@ -306,6 +498,7 @@ void TreeBuilders::deleteTree(TreeNode* root) {
  * @brief Построение B-дерева (ДБД)
  * @param data Массив ключей для вставки
  * @param t Минимальный порядок B-дерева (t ≥ 2)
+ * @param digest Дайджест содержимого (необязательно)
  * @return Корень построенного B-дерева
  *
  * @details
@@ -316,10 +509,22 @@ void TreeBuilders::deleteTree(TreeNode* root) {
  *
  * @note Для t=2 получаем 2-3 дерево
  */
-DBNode* TreeBuilders::buildDBTree(const std::vector<int>& data, int t) {
+DBNode* TreeBuilders::buildDBTree(const std::vector<int>& data, int t, TreeDigest* digest) {
     DBNode* root = nullptr;
     for (int key : data) {
-        insertDBNode(root, key, t, 0);
+        insertDBNode(root, key, t, 0, digest);
+    }
+    return root;
+}
+
+/**
+ * @brief Построение ДБД из потока ключей
+ */
+DBNode* TreeBuilders::buildDBTree(KeySource& source, int t, TreeDigest* digest) {
+    DBNode* root = nullptr;
+    std::vector<int> chunk;
+    while (source.nextChunk(chunk, KeySource::DEFAULT_CHUNK_SIZE)) {
+        for (int key : chunk) insertDBNode(root, key, t, 0, digest);
     }
     return root;
 }
@@ -330,48 +535,145 @@ DBNode* TreeBuilders::buildDBTree(const std::vector<int>& data, int t) {
  * @param key Ключ для вставки
  * @param t Минимальный порядок дерева
  * @param level Уровень текущего узла (0 для корня)
+ * @param digest Дайджест содержимого (обновляется при вставке в лист)
  *
  * @details
  * Рекурсивная вставка с разделением переполненных узлов.
  * Если узел переполняется (имеет 2t ключей), он разделяется на два узла
  * по t-1 ключей каждый, а средний ключ поднимается в родительский узел.
  */
-void TreeBuilders::insertDBNode(DBNode*& node, int key, int t, int level) {
+void TreeBuilders::insertDBNode(DBNode*& node, int key, int t, int level, TreeDigest* digest) {
     if (!node) {
         node = new DBNode(true, level);
         node->keys.push_back(key);
+        if (digest) digest->add(key);
         return;
     }
 
+    OP_STATS_ADD(nodeVisits, 1);
+
+    // Дубликат игнорируется, как в СДП и АВЛ
+    if (std::binary_search(node->keys.begin(), node->keys.end(), key, CountingLess())) return;
+
     int i = node->keys.size() - 1;
 
     if (node->isLeaf) {
         // Вставка в лист
         node->keys.push_back(0);
-        while (i >= 0 && key < node->keys[i]) {
+        while (i >= 0 && OpStats::less(key, node->keys[i])) {
             node->keys[i + 1] = node->keys[i];
             i--;
         }
         node->keys[i + 1] = key;
+        if (digest) digest->add(key);
 
         if (node->keys.size() == 2 * t) {
             // Корень переполнен
             DBNode* newRoot = new DBNode(false, node->level);
             newRoot->children.push_back(node);
             splitChild(newRoot, 0, t);
+            // Половины листа опускаются на уровень ниже нового узла
+            newRoot->children[0]->level = newRoot->level + 1;
+            newRoot->children[1]->level = newRoot->level + 1;
             node = newRoot;
         }
     }
     else {
         // Вставка во внутренний узел
-        while (i >= 0 && key < node->keys[i]) i--;
+        while (i >= 0 && OpStats::less(key, node->keys[i])) i--;
         i++;
         if (i < node->children.size() && node->children[i]->keys.size() == 2 * t) {
             splitChild(node, i, t);
+            if (key == node->keys[i]) return;
             if (key > node->keys[i]) i++;
         }
-        insertDBNode(node->children[i], key, t, level + 1);
+        insertDBNode(node->children[i], key, t, level + 1, digest);
+    }
+}
+
+/**
+ * @brief Сдвиг уровней всех узлов поддерева
+ * @param node Корень поддерева
+ * @param delta Изменение уровня
+ */
+static void shiftLevelsDB(DBNode* node, int delta) {
+    if (!node) return;
+    node->level += delta;
+    for (DBNode* child : node->children) shiftLevelsDB(child, delta);
+}
+
+/**
+ * @brief Удаление ключа из ДБД
+ *
+ * @details
+ * 1. Спуск к узлу с ключом с запоминанием пути (узел, индекс потомка).
+ * 2. Ключ внутреннего узла заменяется предшественником - последним
+ *    ключом самого правого листа левого поддерева; удаляется он из листа.
+ * 3. Если лист опустел, он убирается из родителя вместе с соседним
+ *    разделителем; разделитель вставляется insertDBNode в оставшееся
+ *    соседнее поддерево (он больше/меньше всех его ключей).
+ * 4. Родитель без ключей заменяется своим единственным потомком;
+ *    уровни поднятого поддерева уменьшаются на 1, так что level
+ *    остается глубиной узла.
+ */
+bool TreeBuilders::removeDBNode(DBNode*& root, int key, int t, TreeDigest* digest) {
+    std::vector<std::pair<DBNode*, size_t>> path;
+    DBNode* node = root;
+    size_t index = 0;
+
+    while (node) {
+        index = std::lower_bound(node->keys.begin(), node->keys.end(), key) - node->keys.begin();
+        if (index < node->keys.size() && node->keys[index] == key) break;
+        if (node->isLeaf) return false;
+        path.push_back({ node, index });
+        node = node->children[index];
+    }
+    if (!node) return false;
+    if (digest) digest->remove(key);
+
+    if (!node->isLeaf) {
+        path.push_back({ node, index });
+        DBNode* leaf = node->children[index];
+        while (!leaf->isLeaf) {
+            path.push_back({ leaf, leaf->children.size() - 1 });
+            leaf = leaf->children.back();
+        }
+        node->keys[index] = leaf->keys.back();
+        node = leaf;
+        index = leaf->keys.size() - 1;
+    }
+
+    node->keys.erase(node->keys.begin() + index);
+    if (!node->keys.empty()) return true;
+
+    delete node;
+    if (path.empty()) {
+        root = nullptr;
+        return true;
+    }
+
+    DBNode* parent = path.back().first;
+    size_t child = path.back().second;
+    path.pop_back();
+
+    parent->children.erase(parent->children.begin() + child);
+    size_t separatorIndex = child > 0 ? child - 1 : 0;
+    int separator = parent->keys[separatorIndex];
+    parent->keys.erase(parent->keys.begin() + separatorIndex);
+
+    if (parent->keys.empty()) {
+        DBNode* only = parent->children[0];
+        delete parent;
+        DBNode*& link = path.empty() ? root : path.back().first->children[path.back().second];
+        link = only;
+        shiftLevelsDB(link, -1);
+        insertDBNode(link, separator, t, link->level, nullptr);
     }
+    else {
+        DBNode*& sibling = parent->children[separatorIndex];
+        insertDBNode(sibling, separator, t, sibling->level, nullptr);
+    }
+    return true;
 }
 
 /**
@@ -390,6 +692,7 @@ void TreeBuilders::insertDBNode(DBNode*& node, int key, int t, int level) {
  * 5. Добавляет z как дочерний узел parent
  */
 void TreeBuilders::splitChild(DBNode* parent, int index, int t) {
+    OP_STATS_ADD(splits, 1);
     DBNode* y = parent->children[index];
     DBNode* z = new DBNode(y->isLeaf, y->level);
 
@@ -445,4 +748,179 @@ void TreeBuilders::inOrderTraversalDB(DBNode* node, std::vector<int>& keys) {
     else {
         for (int key : node->keys) keys.push_back(key);
     }
-}
\ No newline at end of file
+}
+
+// ================== DSW ==================
+
+/**
+ * @brief Перебалансировка дерева на месте (алгоритм Дэя–Стаута–Уоррена)
+ * @param root Корень дерева (передается по ссылке)
+ *
+ * @details
+ * Алгоритм:
+ * 1. Правыми поворотами дерево вытягивается в "лозу" - цепочку по указателям right
+ * 2. Лишние узлы нижнего неполного уровня сворачиваются первой серией левых поворотов
+ * 3. Повторные серии левых поворотов уполовинивают лозу, пока она не станет деревом
+ *
+ * Используется фиктивный корень на стеке, поэтому узлы не перевыделяются и
+ * дополнительная память не требуется. Результат - полное дерево минимальной высоты.
+ *
+ * @note Поле height пересчитывается, чтобы после перебалансировки АВЛ-дерево
+ *       можно было продолжать использовать в insertAVL.
+ */
+void TreeBuilders::rebalanceDSW(TreeNode*& root) {
+    if (!root) return;
+
+    TreeNode pseudoRoot(0);
+    pseudoRoot.right = root;
+
+    int size = treeToVine(&pseudoRoot);
+    vineToTree(&pseudoRoot, size);
+
+    root = pseudoRoot.right;
+    updateHeights(root);
+}
+
+/**
+ * @brief Перебалансировка дерева, если оно выродилось
+ * @param root Корень дерева (передается по ссылке)
+ * @param k Допустимый коэффициент высоты
+ * @return true если перебалансировка была выполнена
+ *
+ * @details
+ * Размер и высота вычисляются обходом Морриса: вместо стека временно
+ * прошиваются правые указатели предшественников, которые затем восстанавливаются.
+ * Это важно для вырожденных деревьев, где рекурсия глубины n переполнит стек.
+ */
+bool TreeBuilders::rebalanceIfDegenerate(TreeNode*& root, double k) {
+    if (!root) return false;
+
+    int size = 0;
+    int height = 0;
+    int depth = 0; // глубина текущего узла (корень = 0)
+    TreeNode* current = root;
+
+    while (current) {
+        if (!current->left) {
+            size++;
+            height = std::max(height, depth + 1);
+            current = current->right;
+            depth++;
+            continue;
+        }
+
+        // Поиск in-order предшественника с подсчетом шагов вниз от current
+        TreeNode* pre = current->left;
+        int steps = 1;
+        while (pre->right && pre->right != current) {
+            pre = pre->right;
+            steps++;
+        }
+
+        if (!pre->right) {
+            pre->right = current; // временная прошивка
+            current = current->left;
+            depth++;
+        }
+        else {
+            pre->right = nullptr; // восстановление дерева
+            depth -= steps + 1;   // возврат по прошивке: предшественник был на steps уровней ниже
+            size++;
+            height = std::max(height, depth + 1);
+            current = current->right;
+            depth++;
+        }
+    }
+
+    if (height <= k * std::log2(size + 1.0)) return false;
+
+    rebalanceDSW(root);
+    return true;
+}
+
+/**
+ * @brief Вытягивание дерева в правую лозу
+ * @param pseudoRoot Фиктивный корень
+ * @return Количество узлов
+ *
+ * @details
+ * Пока у очередного узла есть левый потомок, выполняется правый поворот;
+ * иначе хвост лозы сдвигается вправо.
+ */
+int TreeBuilders::treeToVine(TreeNode* pseudoRoot) {
+    TreeNode* tail = pseudoRoot;
+    TreeNode* rest = tail->right;
+    int size = 0;
+
+    while (rest) {
+        if (!rest->left) {
+            tail = rest;
+            rest = rest->right;
+            size++;
+        }
+        else {
+            TreeNode* temp = rest->left;
+            rest->left = temp->right;
+            temp->right = rest;
+            rest = temp;
+            tail->right = temp;
+        }
+    }
+
+    return size;
+}
+
+/**
+ * @brief Сворачивание лозы в сбалансированное дерево
+ * @param pseudoRoot Фиктивный корень лозы
+ * @param size Количество узлов
+ *
+ * @details
+ * Сначала сворачиваются "лишние" узлы сверх ближайшего полного дерева
+ * (2^k - 1 узлов), затем лоза сворачивается пополам, пока не останется один узел.
+ */
+void TreeBuilders::vineToTree(TreeNode* pseudoRoot, int size) {
+    int full = 1;
+    while (full <= size + 1) full <<= 1;
+    full = (full >> 1) - 1;
+
+    compressVine(pseudoRoot, size - full);
+
+    for (size = full; size > 1; size /= 2) {
+        compressVine(pseudoRoot, size / 2);
+    }
+}
+
+/**
+ * @brief Серия левых поворотов вдоль лозы
+ * @param pseudoRoot Фиктивный корень лозы
+ * @param count Количество поворотов
+ *
+ * @details
+ * Каждый второй узел лозы поворотом поднимается над своим предшественником,
+ * который становится его левым потомком.
+ */
+void TreeBuilders::compressVine(TreeNode* pseudoRoot, int count) {
+    TreeNode* scanner = pseudoRoot;
+    for (int i = 0; i < count; i++) {
+        TreeNode* child = scanner->right;
+        scanner->right = child->right;
+        scanner = scanner->right;
+        child->right = scanner->left;
+        scanner->left = child;
+    }
+}
+
+/**
+ * @brief Пересчет поля height в узлах дерева
+ * @param node Корень поддерева
+ * @return Высота поддерева (0 для nullptr)
+ *
+ * @note Вызывается только для уже сбалансированного дерева, поэтому глубина
+ *       рекурсии не превышает log2(n) + 1.
+ */
+int TreeBuilders::updateHeights(TreeNode* node) {
+    if (!node) return 0;
+    node->height = 1 + std::max(updateHeights(node->left), updateHeights(node->right));
+    return node->height;
+}
@@ -3,8 +3,12 @@
 
 #include "tree_node.h"
 #include "db_node.h"
+#include "tree_digest.h"
 #include <vector>
 
+class KeySource;
+class KeyReader;
+
 /**
  * @file tree_builders.h
  * @brief     
@@ -16,6 +20,8 @@
  *  -  -  ()
  *
  *   ,       .
+ *       TreeDigest, 
+ *      .
  */
 class TreeBuilders {
 public:
@@ -24,43 +30,106 @@ public:
     /**
      * @brief      ()
      * @param sortedData    
+     * @param digest   ()
      * @return     
      *
      * @note    .      .
      */
-    static TreeNode* buildPerfectlyBalancedTree(const std::vector<int>& sortedData);
+    static TreeNode* buildPerfectlyBalancedTree(const std::vector<int>& sortedData, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief      
+     * @param sortedSource    
+     * @param count    
+     * @param digest   ()
+     * @return     
+     *
+     * @note    ,    .    
+     *       in-order,   -      log2(n).
+     */
+    static TreeNode* buildPerfectlyBalancedTree(KeySource& sortedSource, int count, TreeDigest* digest = nullptr);
 
     // ====  ====
 
+    /**
+     * @brief        (, )
+     * @param root   ( )
+     * @param key    ( )
+     * @param digest   ()
+     *
+     * @note :      .
+     */
+    static void insertBST(TreeNode*& root, int key, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief        (, )
+     * @param root   ( )
+     * @param key  
+     * @param digest   ()
+     * @return true      
+     *
+     * @note        ( 
+     *       ),   . .
+     */
+    static bool removeBST(TreeNode*& root, int key, TreeDigest* digest = nullptr);
+
     /**
      * @brief     ()
      * @param data   (  )
+     * @param digest   ()
      * @return     
      *
      * @note     .  "".
      */
-    static TreeNode* buildRandomSearchTree(const std::vector<int>& data);
+    static TreeNode* buildRandomSearchTree(const std::vector<int>& data, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief     
+     * @param source   ( )
+     * @param digest   ()
+     * @return     
+     */
+    static TreeNode* buildRandomSearchTree(KeySource& source, TreeDigest* digest = nullptr);
 
     // ====  ====
 
     /**
      * @brief  -   
      * @param data   
+     * @param digest   ()
      * @return    -
      *
      * @note     insertAVL  .
      */
-    static TreeNode* buildAVLTree(const std::vector<int>& data);
+    static TreeNode* buildAVLTree(const std::vector<int>& data, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief  -   
+     * @param source   ( )
+     * @param digest   ()
+     * @return    -
+     */
+    static TreeNode* buildAVLTree(KeySource& source, TreeDigest* digest = nullptr);
 
     /**
      * @brief    -  
      * @param node    
      * @param key   
+     * @param digest   (,   )
      * @return     
      *
      * @note      .
      */
-    static TreeNode* insertAVL(TreeNode* node, int key);
+    static TreeNode* insertAVL(TreeNode* node, int key, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief    -  
+     * @param node    
+     * @param key  
+     * @param digest   (,    )
+     * @return       
+     */
+    static TreeNode* removeAVL(TreeNode* node, int key, TreeDigest* digest = nullptr);
 
     // ====  ====
 
@@ -68,17 +137,45 @@ public:
      * @brief   -  ()    t
      * @param data   
      * @param t    (t >= 2)
+     * @param digest   ()
+     * @return    
+     */
+    static DBNode* buildDBTree(const std::vector<int>& data, int t, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief     
+     * @param source   ( )
+     * @param t    (t >= 2)
+     * @param digest   ()
      * @return    
      */
-    static DBNode* buildDBTree(const std::vector<int>& data, int t);
+    static DBNode* buildDBTree(KeySource& source, int t, TreeDigest* digest = nullptr);
 
     /**
      * @brief    
      * @param node  
      * @param key  
      * @param t   
+     * @param level  
+     * @param digest   ()
+     */
+    static void insertDBNode(DBNode*& node, int key, int t, int level = 0, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief    
+     * @param root   ( )
+     * @param key  
+     * @param t   
+     * @param digest   ()
+     * @return true      
+     *
+     * @note       .
+     *          (  insertDBNode,    
+     *          ):     ,
+     *             .
+     *        level    .
      */
-    static void insertDBNode(DBNode*& node, int key, int t, int level = 0);
+    static bool removeDBNode(DBNode*& root, int key, int t, TreeDigest* digest = nullptr);
 
     /**
      * @brief     
@@ -94,6 +191,28 @@ public:
      */
     static void deleteDBTree(DBNode* root);
 
+    // ====  (DSW) ====
+
+    /**
+     * @brief      
+     * @param root   (  ,   )
+     *
+     * @note   :     "",
+     *         .  O(n), .  O(1).
+     */
+    static void rebalanceDSW(TreeNode*& root);
+
+    /**
+     * @brief  ,   
+     * @param root   (  )
+     * @param k  :      > k * log2(n + 1)
+     * @return true    
+     *
+     * @note      ~2.99 * log2(n),  k = 3
+     *            .
+     */
+    static bool rebalanceIfDegenerate(TreeNode*& root, double k = 3.0);
+
     // ====   ====
 
     /**
@@ -128,14 +247,24 @@ private:
      */
     static TreeNode* buildBalancedTreeRecursive(const std::vector<int>& sortedData, int start, int end);
 
+    /**
+     * @brief     
+     * @param reader     
+     * @param count   
+     * @param digest   (  nullptr)
+     * @return  
+     */
+    static TreeNode* buildBalancedTreeFromStream(KeyReader& reader, int count, TreeDigest* digest);
+
     // ====    ====
 
     /**
      * @brief     (BST)
      * @param root   ( )
      * @param key   
+     * @param digest   (  nullptr)
      */
-    static void insertNode(TreeNode*& root, int key);
+    static void insertNode(TreeNode*& root, int key, TreeDigest* digest);
 
     // ====   BST- ====
 
@@ -178,6 +307,46 @@ private:
      */
     static TreeNode* rotateRight(TreeNode* y);
 
+    /**
+     * @brief     
+     * @param node    
+     * @return   
+     *
+     * @note    ,     
+     *       ,    .
+     */
+    static TreeNode* rebalanceAVL(TreeNode* node);
+
+    // ====   DSW ====
+
+    /**
+     * @brief      (   right)
+     * @param pseudoRoot  ,    -  
+     * @return    
+     */
+    static int treeToVine(TreeNode* pseudoRoot);
+
+    /**
+     * @brief     
+     * @param pseudoRoot   
+     * @param size    
+     */
+    static void vineToTree(TreeNode* pseudoRoot, int size);
+
+    /**
+     * @brief     
+     * @param pseudoRoot   
+     * @param count  
+     */
+    static void compressVine(TreeNode* pseudoRoot, int count);
+
+    /**
+     * @brief   height     
+     * @param node  
+     * @return  
+     */
+    static int updateHeights(TreeNode* node);
+
 };
 
 #endif // TREE_BUILDERS_H
@@ -0,0 +1,64 @@
+﻿#ifndef TREE_DIGEST_H
+#define TREE_DIGEST_H
+
+/**
+ * @file tree_digest.h
+ * @brief Инкрементальная контрольная сумма и отпечаток содержимого дерева
+ *
+ * Дайджест обновляется функциями вставки TreeBuilders, поэтому прочитать его
+ * можно за O(1), без обхода дерева. Сумма ключей 64-битная и не переполняется
+ * на больших наборах, а отпечаток - сумма хешей ключей по модулю 2^64 - не зависит
+ * от порядка вставки. Два дерева с одинаковым набором ключей (ИСДП, СДП, АВЛ, ДБД)
+ * имеют одинаковые дайджесты.
+ */
+struct TreeDigest {
+    long long checkSum = 0;              // Сумма ключей
+    unsigned long long fingerprint = 0;  // Коммутативный отпечаток набора ключей
+    long long count = 0;                 // Количество вставленных ключей
+
+    /**
+     * @brief Учет вставленного ключа
+     * @param key Вставленный ключ
+     */
+    void add(int key) {
+        checkSum += key;
+        fingerprint += mixKey(key);
+        count++;
+    }
+
+    /**
+     * @brief Учет удаленного ключа
+     * @param key Удаленный ключ
+     */
+    void remove(int key) {
+        checkSum -= key;
+        fingerprint -= mixKey(key);
+        count--;
+    }
+
+    /**
+     * @brief Хеш ключа (финализатор SplitMix64)
+     * @param key Ключ
+     * @return 64-битный хеш с хорошим перемешиванием битов
+     *
+     * @note Сумма хешей, в отличие от суммы ключей, различает наборы
+     *       вида {1, 4} и {2, 3}.
+     */
+    static unsigned long long mixKey(int key) {
+        unsigned long long z = static_cast<unsigned long long>(static_cast<unsigned int>(key))
+            + 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    bool operator==(const TreeDigest& other) const {
+        return checkSum == other.checkSum && fingerprint == other.fingerprint && count == other.count;
+    }
+
+    bool operator!=(const TreeDigest& other) const {
+        return !(*this == other);
+    }
+};
+
+#endif // TREE_DIGEST_H
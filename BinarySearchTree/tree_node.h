@@ -1,6 +1,8 @@
 #ifndef TREE_NODE_H
 #define TREE_NODE_H
 
+#include "node_memory.h"
+
 /**
  * @file tree_node.h
  * @brief    / -
@@ -25,6 +27,10 @@ struct TreeNode {
     TreeNode(int k)
         : key(k), left(nullptr), right(nullptr), height(1) {
     }
+
+    //    NodeMemory (   )
+    static void* operator new(std::size_t bytes) { return NodeMemory::allocate(bytes); }
+    static void operator delete(void* pointer, std::size_t bytes) { NodeMemory::deallocate(pointer, bytes); }
 };
 
 #endif // TREE_NODE_H
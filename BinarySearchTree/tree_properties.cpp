@@ -1,4 +1,7 @@
 ﻿#include "tree_properties.h"
+#include "tree_digest.h"
+#include "prefetch.h"
+#include "op_stats.h"
 #include <algorithm>
 #include <iostream>
 
@@ -43,8 +46,9 @@ int TreeProperties::calculateHeight(TreeNode* root) {
  *
  * Контрольная сумма - это сумма всех ключей в дереве.
  * Используется для проверки, что два дерева содержат одинаковые данные.
+ * Сумма накапливается в 64 битах: 32-битная переполнялась уже на сотнях тысяч ключей.
  */
-int TreeProperties::calculateCheckSum(TreeNode* root) {
+long long TreeProperties::calculateCheckSum(TreeNode* root) {
     if (root == nullptr) {
         return 0;
     }
@@ -52,6 +56,20 @@ int TreeProperties::calculateCheckSum(TreeNode* root) {
     return root->key + calculateCheckSum(root->left) + calculateCheckSum(root->right);
 }
 
+/**
+ * @brief Вычисление отпечатка набора ключей
+ *
+ * Сумма хешей ключей коммутативна, поэтому деревья разной формы
+ * с одинаковым набором ключей имеют одинаковый отпечаток.
+ */
+unsigned long long TreeProperties::calculateFingerprint(TreeNode* root) {
+    if (root == nullptr) {
+        return 0;
+    }
+
+    return TreeDigest::mixKey(root->key) + calculateFingerprint(root->left) + calculateFingerprint(root->right);
+}
+
 /**
  * @brief Вычисление средней высоты дерева
  *
@@ -143,6 +161,8 @@ TreeNode* TreeProperties::searchNode(TreeNode* root, int key) {
     TreeNode* current = root;
 
     while (current != nullptr) {
+        OP_STATS_ADD(nodeVisits, 1);
+        OP_STATS_ADD(comparisons, 1);
         if (key == current->key) {
             return current;  // Узел найден
         }
@@ -157,6 +177,129 @@ TreeNode* TreeProperties::searchNode(TreeNode* root, int key) {
     return nullptr;  // Узел не найден
 }
 
+/**
+ * @brief Пакетный поиск с чередованием запросов и предвыборкой
+ *
+ * @details
+ * Асинхронный доступ к памяти (AMAC): держится окно из groupSize активных
+ * поисков. За один проход по окну каждый поиск сравнивает ключ с уже
+ * загруженным узлом, переходит к потомку и запрашивает его в кэш. К моменту
+ * следующего обращения к этому поиску узел, как правило, уже в кэше.
+ * Завершившийся поиск сразу заменяется следующим ключом из пакета,
+ * поэтому поиски разной длины не простаивают.
+ */
+void TreeProperties::searchBatch(TreeNode* root, const std::vector<int>& keys,
+    std::vector<TreeNode*>& results, int groupSize) {
+    results.assign(keys.size(), nullptr);
+    if (root == nullptr || keys.empty()) {
+        return;
+    }
+
+    struct Lookup {
+        TreeNode* node;  // Текущий узел поиска
+        size_t index;    // Индекс ключа в пакете
+    };
+
+    const size_t windowSize = static_cast<size_t>(std::max(groupSize, 1));
+    std::vector<Lookup> window;
+    window.reserve(windowSize);
+
+    size_t next = 0;
+    while (window.size() < windowSize && next < keys.size()) {
+        window.push_back({ root, next++ });
+    }
+    prefetchRead(root);
+
+    while (!window.empty()) {
+        for (size_t slot = 0; slot < window.size(); ) {
+            Lookup& lookup = window[slot];
+            TreeNode* node = lookup.node;
+            int key = keys[lookup.index];
+
+            if (node == nullptr || node->key == key) {
+                // Поиск завершен: слот занимает следующий ключ или последний активный поиск
+                results[lookup.index] = node;
+                if (next < keys.size()) {
+                    lookup = { root, next++ };
+                    slot++;
+                }
+                else {
+                    lookup = window.back();
+                    window.pop_back();
+                }
+                continue;
+            }
+
+            node = key < node->key ? node->left : node->right;
+            prefetchRead(node);
+            lookup.node = node;
+            slot++;
+        }
+    }
+}
+
+/**
+ * @brief Пакетный поиск отсортированного набора ключей за один спуск
+ *
+ * @details
+ * Каждая задача - пара (узел, диапазон [lo, hi) отсортированных ключей).
+ * В узле двоичным поиском выделяются ключи, равные ключу узла (они найдены),
+ * меньшие уходят в левое поддерево, большие - в правое. Пустые диапазоны
+ * дальше не спускаются, поэтому верхние уровни дерева посещаются один раз
+ * на весь пакет, а не на каждый ключ.
+ *
+ * Диапазон из одного ключа дальше ищется обычным спуском searchNode.
+ * Используется явный стек, чтобы не переполнить стек вызовов на вырожденных СДП.
+ */
+void TreeProperties::searchSortedBatch(TreeNode* root, const std::vector<int>& sortedKeys,
+    std::vector<TreeNode*>& results) {
+    results.assign(sortedKeys.size(), nullptr);
+
+    if (!std::is_sorted(sortedKeys.begin(), sortedKeys.end())) {
+        std::cerr << "Предупреждение: ключи для searchSortedBatch не отсортированы!" << std::endl;
+        return;
+    }
+
+    struct Task {
+        TreeNode* node;
+        size_t lo;
+        size_t hi;
+    };
+
+    std::vector<Task> stack;
+    if (root != nullptr && !sortedKeys.empty()) {
+        stack.push_back({ root, 0, sortedKeys.size() });
+    }
+
+    while (!stack.empty()) {
+        Task task = stack.back();
+        stack.pop_back();
+
+        // Одиночный ключ: обычный спуск без двоичного поиска по диапазону
+        if (task.hi - task.lo == 1) {
+            results[task.lo] = searchNode(task.node, sortedKeys[task.lo]);
+            continue;
+        }
+
+        auto first = sortedKeys.begin() + task.lo;
+        auto last = sortedKeys.begin() + task.hi;
+        auto equal = std::equal_range(first, last, task.node->key);
+
+        size_t eqLo = equal.first - sortedKeys.begin();
+        size_t eqHi = equal.second - sortedKeys.begin();
+        for (size_t i = eqLo; i < eqHi; i++) {
+            results[i] = task.node;
+        }
+
+        if (eqHi < task.hi && task.node->right != nullptr) {
+            stack.push_back({ task.node->right, eqHi, task.hi });
+        }
+        if (task.lo < eqLo && task.node->left != nullptr) {
+            stack.push_back({ task.node->left, task.lo, eqLo });
+        }
+    }
+}
+
 /**
  * @brief Вычисление контрольной суммы B-дерева (ДБД)
  * @param root Указатель на корень B-дерева
@@ -170,14 +313,27 @@ TreeNode* TreeProperties::searchNode(TreeNode* root, int key) {
  *
  * Используется для проверки корректности построения дерева.
  */
-int TreeProperties::calculateCheckSumDB(DBNode* root) {
+long long TreeProperties::calculateCheckSumDB(DBNode* root) {
     if (!root) return 0;
-    int sum = 0;
+    long long sum = 0;
     for (int key : root->keys) sum += key;
     for (DBNode* child : root->children) sum += calculateCheckSumDB(child);
     return sum;
 }
 
+/**
+ * @brief Вычисление отпечатка набора ключей B-дерева (ДБД)
+ * @param root Указатель на корень B-дерева
+ * @return Сумма хешей всех ключей по модулю 2^64
+ */
+unsigned long long TreeProperties::calculateFingerprintDB(DBNode* root) {
+    if (!root) return 0;
+    unsigned long long fingerprint = 0;
+    for (int key : root->keys) fingerprint += TreeDigest::mixKey(key);
+    for (DBNode* child : root->children) fingerprint += calculateFingerprintDB(child);
+    return fingerprint;
+}
+
 /**
  * @brief Вычисление взвешенной суммы уровней B-дерева
  * @param root Указатель на корень B-дерева
@@ -230,30 +386,244 @@ int TreeProperties::calculateHeightDB(const DBNode* node) {
  * @return Указатель на узел, содержащий ключ, или nullptr, если не найден
  *
  * @details
- * Выполняет поиск ключа в B-дереве с помощью рекурсивного обхода.
- * Алгоритм:
- * 1. Проверяет ключи текущего узла
- * 2. Если ключ найден - возвращает узел
- * 3. Иначе рекурсивно ищет в дочерних узлах
+ * Спуск от корня, как в обычном B-дереве. Ключи внутри узла упорядочены
+ * (insertDBNode вставляет с сохранением порядка), поэтому в узле двоичным
+ * поиском находится первый ключ >= key:
+ * 1. Если он равен key - узел найден
+ * 2. Иначе поиск продолжается в потомке слева от этого ключа
+ * 3. В листе без совпадения ключ отсутствует
  *
- * @note В B-дереве ключи внутри узла не обязательно отсортированы,
- * поэтому используется линейный поиск по ключам узла.
+ * Временная сложность: O(log n) вместо обхода всех узлов.
  */
 DBNode* TreeProperties::searchNodeDB(DBNode* root, int key) {
-    if (!root) return nullptr;
+    DBNode* current = root;
 
-    // Проверяем ключи текущего узла
-    for (int k : root->keys) {
-        if (k == key) return root;
+    while (current) {
+        OP_STATS_ADD(nodeVisits, 1);
+        auto it = std::lower_bound(current->keys.begin(), current->keys.end(), key, CountingLess());
+        if (it != current->keys.end() && *it == key) {
+            return current;
+        }
+        if (current->isLeaf) {
+            return nullptr;
+        }
+        current = current->children[it - current->keys.begin()];
     }
 
-    // Рекурсивно обходим детей
-    for (DBNode* child : root->children) {
-        DBNode* found = searchNodeDB(child, key);
-        if (found) return found;
+    return nullptr;
+}
+
+/**
+ * @brief Вычисление всех характеристик дерева за один обход
+ *
+ * @details
+ * Итеративный обход в прямом порядке с явным стеком пар (узел, глубина).
+ * За одно посещение узла обновляются все счетчики:
+ * - размер, сумма ключей, отпечаток и ширина уровня глубины узла
+ * - высота как максимальная глубина + 1
+ * - длина внутренних путей как сумма глубин
+ * - количество и суммарная глубина листьев
+ */
+TreeStats TreeProperties::calculateStats(TreeNode* root) {
+    TreeStats stats;
+    if (root == nullptr) {
+        return stats;
     }
 
-    return nullptr;
+    std::vector<std::pair<TreeNode*, int>> stack;
+    stack.reserve(64);
+    stack.push_back({ root, 0 });
+
+    long long leafDepthSum = 0;
+
+    while (!stack.empty()) {
+        TreeNode* node = stack.back().first;
+        int depth = stack.back().second;
+        stack.pop_back();
+
+        stats.size++;
+        stats.checkSum += node->key;
+        stats.fingerprint += TreeDigest::mixKey(node->key);
+        stats.internalPathLength += depth;
+        if (depth >= static_cast<int>(stats.levelWidths.size())) {
+            stats.levelWidths.push_back(0);
+        }
+        stats.levelWidths[depth]++;
+
+        if (node->left == nullptr && node->right == nullptr) {
+            stats.leafCount++;
+            leafDepthSum += depth;
+            continue;
+        }
+
+        // Правый потомок кладется первым, чтобы левый обрабатывался раньше
+        if (node->right != nullptr) stack.push_back({ node->right, depth + 1 });
+        if (node->left != nullptr) stack.push_back({ node->left, depth + 1 });
+    }
+
+    stats.height = static_cast<int>(stats.levelWidths.size());
+    stats.averageLeafDepth = static_cast<double>(leafDepthSum) / stats.leafCount;
+
+    return stats;
 }
 
+/**
+ * @brief Вычисление всех характеристик B-дерева (ДБД) за один обход
+ *
+ * @details
+ * Аналогичен calculateStats, но каждый узел вносит в размер, контрольную сумму,
+ * длину путей и ширину уровня все свои ключи. Высота - количество уровней,
+ * как в calculateHeightDB; длина путей совпадает с calculateLevelsDB.
+ */
+TreeStats TreeProperties::calculateStatsDB(DBNode* root) {
+    TreeStats stats;
+    if (!root) return stats;
+
+    std::vector<std::pair<DBNode*, int>> stack;
+    stack.reserve(64);
+    stack.push_back({ root, 0 });
+
+    long long leafDepthSum = 0;
+
+    while (!stack.empty()) {
+        DBNode* node = stack.back().first;
+        int depth = stack.back().second;
+        stack.pop_back();
+
+        int keyCount = static_cast<int>(node->keys.size());
+        stats.size += keyCount;
+        for (int key : node->keys) {
+            stats.checkSum += key;
+            stats.fingerprint += TreeDigest::mixKey(key);
+        }
+        stats.internalPathLength += static_cast<long long>(depth) * keyCount;
+        if (depth >= static_cast<int>(stats.levelWidths.size())) {
+            stats.levelWidths.push_back(0);
+        }
+        stats.levelWidths[depth] += keyCount;
+
+        if (node->isLeaf) {
+            stats.leafCount++;
+            leafDepthSum += depth;
+            continue;
+        }
 
+        for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) {
+            stack.push_back({ *it, depth + 1 });
+        }
+    }
+
+    stats.height = static_cast<int>(stats.levelWidths.size());
+    if (stats.leafCount > 0) {
+        stats.averageLeafDepth = static_cast<double>(leafDepthSum) / stats.leafCount;
+    }
+
+    return stats;
+}
+
+/**
+ * @brief Пакетный поиск отсортированного набора ключей в B-дереве (ДБД)
+ *
+ * @details
+ * Аналогичен searchSortedBatch: диапазон [lo, hi) отсортированных ключей
+ * в узле делится ключами узла на части. Ключи меньше keys[0] уходят
+ * в children[0], между keys[i-1] и keys[i] - в children[i], больше
+ * последнего ключа - в последнего потомка. Равные ключам узла найдены.
+ */
+void TreeProperties::searchSortedBatchDB(DBNode* root, const std::vector<int>& sortedKeys,
+    std::vector<DBNode*>& results) {
+    results.assign(sortedKeys.size(), nullptr);
+
+    if (!std::is_sorted(sortedKeys.begin(), sortedKeys.end())) {
+        std::cerr << "Предупреждение: ключи для searchSortedBatchDB не отсортированы!" << std::endl;
+        return;
+    }
+
+    struct Task {
+        DBNode* node;
+        size_t lo;
+        size_t hi;
+    };
+
+    std::vector<Task> stack;
+    if (root && !sortedKeys.empty()) {
+        stack.push_back({ root, 0, sortedKeys.size() });
+    }
+
+    while (!stack.empty()) {
+        Task task = stack.back();
+        stack.pop_back();
+
+        size_t lo = task.lo;
+        for (size_t k = 0; k <= task.node->keys.size() && lo < task.hi; k++) {
+            // Граница части для потомка k: первый ключ пакета >= keys[k]
+            size_t hi = task.hi;
+            size_t eqHi = task.hi;
+            if (k < task.node->keys.size()) {
+                auto equal = std::equal_range(sortedKeys.begin() + lo, sortedKeys.begin() + task.hi,
+                    task.node->keys[k]);
+                hi = equal.first - sortedKeys.begin();
+                eqHi = equal.second - sortedKeys.begin();
+                for (size_t i = hi; i < eqHi; i++) {
+                    results[i] = task.node;
+                }
+            }
+
+            if (lo < hi && !task.node->isLeaf) {
+                stack.push_back({ task.node->children[k], lo, hi });
+            }
+            lo = eqHi;
+        }
+    }
+}
+
+/**
+ * @brief Ключи бинарного дерева из диапазона [low, high]
+ *
+ * @details
+ * In-order обход со стеком: влево спускаемся только пока ключ > low,
+ * обход заканчивается на первом ключе > high.
+ */
+void TreeProperties::rangeQuery(TreeNode* root, int low, int high, std::vector<int>& result) {
+    std::vector<TreeNode*> stack;
+    TreeNode* node = root;
+
+    while (node || !stack.empty()) {
+        while (node) {
+            if (node->key < low) {
+                // Узел и его левое поддерево левее диапазона
+                node = node->right;
+            }
+            else {
+                stack.push_back(node);
+                node = node->left;
+            }
+        }
+        if (stack.empty()) break;
+
+        node = stack.back();
+        stack.pop_back();
+        if (node->key > high) break;
+        result.push_back(node->key);
+        node = node->right;
+    }
+}
+
+/**
+ * @brief Ключи B-дерева (ДБД) из диапазона [low, high]
+ *
+ * @details
+ * В узле начинаем с первого ключа >= low; перед каждым ключом обходим
+ * поддерево слева от него. Останавливаемся после поддерева слева от
+ * первого ключа > high.
+ */
+void TreeProperties::rangeQueryDB(DBNode* root, int low, int high, std::vector<int>& result) {
+    if (!root) return;
+
+    size_t i = std::lower_bound(root->keys.begin(), root->keys.end(), low) - root->keys.begin();
+    for (;; ++i) {
+        if (!root->isLeaf) rangeQueryDB(root->children[i], low, high, result);
+        if (i >= root->keys.size() || root->keys[i] > high) break;
+        result.push_back(root->keys[i]);
+    }
+}
@@ -13,6 +13,23 @@
  * бинарных деревьев: размера, высоты, контрольной суммы и средней высоты.
  */
 
+/**
+ * @brief Сводные характеристики дерева, собранные за один обход
+ *
+ * Для ДБД размер, длина путей и ширина уровней считаются в ключах,
+ * а количество листьев и их глубина - в узлах.
+ */
+struct TreeStats {
+    int size = 0;                     // Количество узлов (ключей для ДБД)
+    int height = 0;                   // Высота (в вершинах/уровнях, как calculateHeight)
+    long long checkSum = 0;           // Сумма ключей
+    unsigned long long fingerprint = 0; // Отпечаток набора ключей (как TreeDigest)
+    int leafCount = 0;                // Количество листьев
+    double averageLeafDepth = 0.0;    // Средняя глубина листьев (как calculateAverageHeight)
+    long long internalPathLength = 0; // Сумма глубин всех узлов (ключей для ДБД)
+    std::vector<int> levelWidths;     // Количество узлов (ключей) на каждом уровне
+};
+
 class TreeProperties {
 public:
     /**
@@ -36,12 +53,23 @@ public:
     /**
      * @brief Вычисление контрольной суммы данных дерева
      * @param root Указатель на корень дерева
-     * @return Сумма ключей всех узлов дерева
+     * @return Сумма ключей всех узлов дерева (64-битная, без переполнения)
      *
      * @note Контрольная сумма используется для проверки корректности данных
      *       при сравнении различных представлений одного набора данных.
+     *       Для построенных деревьев ту же сумму за O(1) дает TreeDigest.
+     */
+    static long long calculateCheckSum(TreeNode* root);
+
+    /**
+     * @brief Вычисление отпечатка набора ключей дерева
+     * @param root Указатель на корень дерева
+     * @return Сумма хешей TreeDigest::mixKey всех ключей по модулю 2^64
+     *
+     * @note Не зависит от формы дерева; совпадает с TreeDigest::fingerprint,
+     *       накопленным при построении.
      */
-    static int calculateCheckSum(TreeNode* root);
+    static unsigned long long calculateFingerprint(TreeNode* root);
 
     /**
      * @brief Вычисление средней высоты дерева
@@ -73,14 +101,50 @@ public:
      */
     static TreeNode* searchNode(TreeNode* root, int key);
 
+    /**
+     * @brief Пакетный поиск с чередованием запросов и предвыборкой
+     * @param root Указатель на корень дерева поиска
+     * @param keys Ключи для поиска
+     * @param results Результаты: results[i] - узел с ключом keys[i] или nullptr
+     * @param groupSize Количество одновременно выполняемых поисков
+     *
+     * @note Поиски продвигаются по очереди на один уровень, а адрес следующего
+     *       узла каждого поиска заранее запрашивается в кэш. Промахи кэша
+     *       разных поисков перекрываются, вместо того чтобы ждать их по одному.
+     */
+    static void searchBatch(TreeNode* root, const std::vector<int>& keys,
+        std::vector<TreeNode*>& results, int groupSize = 16);
+
+    /**
+     * @brief Пакетный поиск отсортированного набора ключей за один спуск
+     * @param root Указатель на корень дерева поиска
+     * @param sortedKeys Ключи для поиска, отсортированные по возрастанию
+     * @param results Результаты: results[i] - узел с ключом sortedKeys[i] или nullptr
+     *
+     * @note Общая часть путей поиска проходится один раз: в каждом узле
+     *       диапазон ключей делится на левую и правую части, как при слиянии.
+     *       Для m ключей в дереве из n узлов стоимость ~O(m log(n/m)) вместо m спусков.
+     * @warning Неотсортированный пакет отклоняется: выводится предупреждение,
+     *          все результаты nullptr.
+     */
+    static void searchSortedBatch(TreeNode* root, const std::vector<int>& sortedKeys,
+        std::vector<TreeNode*>& results);
+
     /**
      * @brief Вычисление контрольной суммы B-дерева (ДБД)
      * @param root Указатель на корень B-дерева
-     * @return Сумма всех ключей в дереве
+     * @return Сумма всех ключей в дереве (64-битная)
      *
      * @note Используется для проверки корректности построения B-дерева
      */
-    static int calculateCheckSumDB(DBNode* root);
+    static long long calculateCheckSumDB(DBNode* root);
+
+    /**
+     * @brief Вычисление отпечатка набора ключей B-дерева (ДБД)
+     * @param root Указатель на корень B-дерева
+     * @return Сумма хешей TreeDigest::mixKey всех ключей по модулю 2^64
+     */
+    static unsigned long long calculateFingerprintDB(DBNode* root);
 
     /**
      * @brief Вычисление взвешенной суммы уровней B-дерева
@@ -107,10 +171,60 @@ public:
      * @param key Ключ для поиска
      * @return Указатель на узел, содержащий ключ, или nullptr, если не найден
      *
-     * @note Использует рекурсивный обход всех узлов B-дерева
+     * @note Спускается от корня, выбирая потомка двоичным поиском по ключам узла.
      */
     static DBNode* searchNodeDB(DBNode* root, int key);
 
+    /**
+     * @brief Пакетный поиск отсортированного набора ключей в B-дереве (ДБД)
+     * @param root Корень B-дерева
+     * @param sortedKeys Ключи для поиска, отсортированные по возрастанию
+     * @param results Результаты: results[i] - узел, содержащий sortedKeys[i], или nullptr
+     *
+     * @note В каждом узле диапазон ключей делится между потомками по ключам узла.
+     * @warning Неотсортированный пакет отклоняется, как в searchSortedBatch.
+     */
+    static void searchSortedBatchDB(DBNode* root, const std::vector<int>& sortedKeys,
+        std::vector<DBNode*>& results);
+
+    /**
+     * @brief Ключи бинарного дерева из диапазона [low, high]
+     * @param root Указатель на корень дерева
+     * @param low Нижняя граница (включительно)
+     * @param high Верхняя граница (включительно)
+     * @param result Ключи диапазона по возрастанию (добавляются в конец)
+     *
+     * @note Обходятся только поддеревья, пересекающие диапазон: O(log n + k)
+     *       для сбалансированного дерева. Итеративно.
+     */
+    static void rangeQuery(TreeNode* root, int low, int high, std::vector<int>& result);
+
+    /**
+     * @brief Ключи B-дерева (ДБД) из диапазона [low, high]
+     * @param root Корень B-дерева
+     * @param low Нижняя граница (включительно)
+     * @param high Верхняя граница (включительно)
+     * @param result Ключи диапазона по возрастанию (добавляются в конец)
+     */
+    static void rangeQueryDB(DBNode* root, int low, int high, std::vector<int>& result);
+
+    /**
+     * @brief Вычисление всех характеристик дерева за один обход
+     * @param root Указатель на корень дерева
+     * @return Размер, высота, контрольная сумма, листья, длина путей и ширина уровней
+     *
+     * @note Заменяет последовательные вызовы calculateSize, calculateHeight,
+     *       calculateCheckSum и calculateAverageHeight. Обход итеративный,
+     *       поэтому не переполняет стек на вырожденных СДП.
+     */
+    static TreeStats calculateStats(TreeNode* root);
+
+    /**
+     * @brief Вычисление всех характеристик B-дерева (ДБД) за один обход
+     * @param root Указатель на корень B-дерева
+     * @return Характеристики дерева (размер и ширина уровней - в ключах)
+     */
+    static TreeStats calculateStatsDB(DBNode* root);
 
 
 private:
@@ -0,0 +1,338 @@
+﻿/**
+ * @file tree_snapshot.cpp
+ * @brief Реализация двоичных снимков деревьев
+ */
+
+#include "tree_snapshot.h"
+#include "tree_builders.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// Сигнатура и версия формата снимка
+static const char SNAPSHOT_MAGIC[4] = { 'B', 'S', 'T', 'S' };
+static const std::uint32_t SNAPSHOT_VERSION = 1;
+
+// Вид дерева в снимке
+static const std::uint32_t KIND_BINARY = 0;
+static const std::uint32_t KIND_DB = 1;
+
+/**
+ * @brief Заголовок файла снимка
+ */
+struct SnapshotHeader {
+    char magic[4];
+    std::uint32_t version;
+    std::uint32_t kind;
+    std::uint32_t degree;      // t для ДБД, 0 для бинарного дерева
+    std::uint64_t nodeCount;
+    std::uint64_t keyCount;
+    std::uint64_t shapeBytes;
+};
+
+static_assert(sizeof(SnapshotHeader) == 40, "Заголовок снимка не должен содержать выравнивания");
+
+// ================== Файл снимка ==================
+
+/**
+ * @brief Запись заголовка, ключей и формы
+ * @return Размер файла в байтах (-1 при ошибке)
+ */
+static long long writeSnapshot(const std::string& path, std::uint32_t kind, std::uint32_t degree,
+    std::uint64_t nodeCount, const std::vector<int>& keys, const std::vector<unsigned char>& shape) {
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, 4);
+    header.version = SNAPSHOT_VERSION;
+    header.kind = kind;
+    header.degree = degree;
+    header.nodeCount = nodeCount;
+    header.keyCount = keys.size();
+    header.shapeBytes = shape.size();
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось создать файл снимка " << path << std::endl;
+        return -1;
+    }
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1;
+    if (ok && !keys.empty()) ok = std::fwrite(keys.data(), sizeof(int), keys.size(), file) == keys.size();
+    if (ok && !shape.empty()) ok = std::fwrite(shape.data(), 1, shape.size(), file) == shape.size();
+    ok = std::fclose(file) == 0 && ok;
+    if (!ok) {
+        std::cerr << "Предупреждение: ошибка записи файла снимка " << path << std::endl;
+        return -1;
+    }
+    return static_cast<long long>(sizeof(header) + keys.size() * sizeof(int) + shape.size());
+}
+
+/**
+ * @brief Чтение снимка заданного вида
+ *
+ * @details
+ * Размеры из заголовка сверяются с размером файла до выделения памяти,
+ * поэтому поврежденный заголовок не приводит к огромным выделениям.
+ */
+static bool readSnapshot(const std::string& path, std::uint32_t kind, SnapshotHeader& header,
+    std::vector<int>& keys, std::vector<unsigned char>& shape) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось открыть файл снимка " << path << std::endl;
+        return false;
+    }
+
+    if (std::fread(&header, sizeof(header), 1, file) != 1 ||
+        std::memcmp(header.magic, SNAPSHOT_MAGIC, 4) != 0 || header.version != SNAPSHOT_VERSION) {
+        std::fclose(file);
+        std::cerr << "Предупреждение: " << path << " не является файлом снимка" << std::endl;
+        return false;
+    }
+    if (header.kind != kind) {
+        std::fclose(file);
+        std::cerr << "Предупреждение: снимок " << path << " содержит дерево другого вида" << std::endl;
+        return false;
+    }
+
+    long fileSize = -1;
+    if (std::fseek(file, 0, SEEK_END) == 0) fileSize = std::ftell(file);
+    std::fseek(file, sizeof(header), SEEK_SET);
+    std::uint64_t payload = header.keyCount * sizeof(int) + header.shapeBytes;
+    if (header.keyCount > (1ULL << 40) || header.shapeBytes > (1ULL << 40) ||
+        (fileSize >= 0 && sizeof(header) + payload != static_cast<std::uint64_t>(fileSize))) {
+        std::fclose(file);
+        std::cerr << "Предупреждение: снимок " << path << " обрезан или поврежден" << std::endl;
+        return false;
+    }
+
+    keys.resize(static_cast<size_t>(header.keyCount));
+    shape.resize(static_cast<size_t>(header.shapeBytes));
+    bool ok = (keys.empty() || std::fread(keys.data(), sizeof(int), keys.size(), file) == keys.size()) &&
+        (shape.empty() || std::fread(shape.data(), 1, shape.size(), file) == shape.size());
+    std::fclose(file);
+    if (!ok) {
+        std::cerr << "Предупреждение: снимок " << path << " обрезан или поврежден" << std::endl;
+    }
+    return ok;
+}
+
+static void addKeys(TreeDigest* digest, const std::vector<int>& keys) {
+    if (!digest) return;
+    for (int key : keys) digest->add(key);
+}
+
+// ================== Бинарное дерево ==================
+
+/**
+ * @brief Сохранение бинарного дерева
+ *
+ * Pre-order обход со стеком (глубина вырожденного СДП не ограничивает
+ * сохранение): ключ узла и 2 бита формы - бит 0 для левого потомка,
+ * бит 1 для правого, по 4 узла в байте.
+ */
+long long TreeSnapshot::save(TreeNode* root, const std::string& path) {
+    std::vector<int> keys;
+    std::vector<unsigned char> shape;
+    std::vector<TreeNode*> stack;
+    if (root) stack.push_back(root);
+
+    while (!stack.empty()) {
+        TreeNode* node = stack.back();
+        stack.pop_back();
+
+        size_t index = keys.size();
+        if (index % 4 == 0) shape.push_back(0);
+        unsigned char bits = (node->left ? 1 : 0) | (node->right ? 2 : 0);
+        shape.back() |= static_cast<unsigned char>(bits << (2 * (index % 4)));
+        keys.push_back(node->key);
+
+        if (node->right) stack.push_back(node->right);
+        if (node->left) stack.push_back(node->left);
+    }
+
+    return writeSnapshot(path, KIND_BINARY, 0, keys.size(), keys, shape);
+}
+
+/**
+ * @brief Загрузка бинарного дерева
+ *
+ * @details
+ * Узлы создаются в pre-order. slot - место, куда будет подвешен следующий
+ * узел: левая ссылка текущего узла, если у него есть левый потомок, иначе
+ * правая ссылка ближайшего узла, чей правый потомок еще не подвешен
+ * (стек pendingRight). Форма проверяется по ходу: лишний или недостающий
+ * узел означает поврежденный снимок.
+ *
+ * В pre-order потомки идут после родителя, поэтому высоты считаются
+ * одним проходом по узлам в обратном порядке.
+ */
+bool TreeSnapshot::load(const std::string& path, TreeNode*& root, TreeDigest* digest) {
+    root = nullptr;
+    SnapshotHeader header;
+    std::vector<int> keys;
+    std::vector<unsigned char> shape;
+    if (!readSnapshot(path, KIND_BINARY, header, keys, shape)) return false;
+
+    size_t count = keys.size();
+    bool ok = header.nodeCount == count && shape.size() == (count + 3) / 4;
+
+    std::vector<TreeNode*> nodes;
+    std::vector<TreeNode*> pendingRight;
+    TreeNode** slot = count > 0 ? &root : nullptr;
+    if (ok) nodes.reserve(count);
+    for (size_t i = 0; ok && i < count; i++) {
+        if (!slot) {
+            ok = false;
+            break;
+        }
+        TreeNode* node = new TreeNode(keys[i]);
+        *slot = node;
+        nodes.push_back(node);
+
+        unsigned bits = (shape[i / 4] >> (2 * (i % 4))) & 3;
+        if (bits & 2) pendingRight.push_back(node);
+        if (bits & 1) {
+            slot = &node->left;
+        }
+        else if (!pendingRight.empty()) {
+            slot = &pendingRight.back()->right;
+            pendingRight.pop_back();
+        }
+        else {
+            slot = nullptr;
+        }
+    }
+    if (ok && slot) ok = false;
+
+    if (!ok) {
+        std::cerr << "Предупреждение: снимок " << path << " содержит некорректную форму дерева" << std::endl;
+        TreeBuilders::deleteTree(root);
+        root = nullptr;
+        return false;
+    }
+
+    for (size_t i = count; i-- > 0;) {
+        TreeNode* node = nodes[i];
+        int leftHeight = node->left ? node->left->height : 0;
+        int rightHeight = node->right ? node->right->height : 0;
+        node->height = 1 + std::max(leftHeight, rightHeight);
+    }
+    addKeys(digest, keys);
+    return true;
+}
+
+// ================== ДБД ==================
+
+static void writeVarint(std::vector<unsigned char>& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+static bool readVarint(const std::vector<unsigned char>& data, size_t& position, unsigned long long& value) {
+    value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (position >= data.size()) return false;
+        unsigned char byte = data[position++];
+        value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Сохранение ДБД
+ *
+ * Узлы в pre-order: ключи узла, затем поддеревья слева направо.
+ * У внутреннего узла keys.size() + 1 потомков, поэтому числа ключей
+ * и признака листа достаточно, чтобы восстановить ветвление.
+ */
+long long TreeSnapshot::save(DBNode* root, int t, const std::string& path) {
+    std::vector<int> keys;
+    std::vector<unsigned char> shape;
+    std::vector<DBNode*> stack;
+    unsigned long long nodeCount = 0;
+    if (root) stack.push_back(root);
+
+    while (!stack.empty()) {
+        DBNode* node = stack.back();
+        stack.pop_back();
+        nodeCount++;
+
+        writeVarint(shape, node->keys.size() * 2 + (node->isLeaf ? 1 : 0));
+        keys.insert(keys.end(), node->keys.begin(), node->keys.end());
+        if (!node->isLeaf) {
+            for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) stack.push_back(*it);
+        }
+    }
+
+    return writeSnapshot(path, KIND_DB, static_cast<std::uint32_t>(t), nodeCount, keys, shape);
+}
+
+/**
+ * @brief Загрузка ДБД
+ *
+ * @details
+ * Стек содержит внутренние узлы, которым еще не хватает потомков;
+ * вершина стека - родитель следующего узла, уровень узла на единицу
+ * больше уровня родителя. Узел снимается со стека, как только получил
+ * keys.size() + 1 потомков.
+ */
+bool TreeSnapshot::load(const std::string& path, DBNode*& root, int& t, TreeDigest* digest) {
+    root = nullptr;
+    SnapshotHeader header;
+    std::vector<int> keys;
+    std::vector<unsigned char> shape;
+    if (!readSnapshot(path, KIND_DB, header, keys, shape)) return false;
+
+    bool ok = header.nodeCount <= keys.size();
+    std::vector<DBNode*> stack;
+    size_t position = 0;
+    size_t keyOffset = 0;
+    for (std::uint64_t i = 0; ok && i < header.nodeCount; i++) {
+        unsigned long long descriptor;
+        if (!readVarint(shape, position, descriptor)) {
+            ok = false;
+            break;
+        }
+        unsigned long long keyCount = descriptor >> 1;
+        bool leaf = (descriptor & 1) != 0;
+        if (keyCount == 0 || keyCount > keys.size() - keyOffset || (root && stack.empty())) {
+            ok = false;
+            break;
+        }
+
+        DBNode* node = new DBNode(leaf, stack.empty() ? 0 : stack.back()->level + 1);
+        node->keys.assign(keys.begin() + keyOffset, keys.begin() + keyOffset + keyCount);
+        keyOffset += keyCount;
+
+        if (stack.empty()) {
+            root = node;
+        }
+        else {
+            DBNode* parent = stack.back();
+            parent->children.push_back(node);
+            if (parent->children.size() == parent->keys.size() + 1) stack.pop_back();
+        }
+        if (!leaf) {
+            node->children.reserve(keyCount + 1);
+            stack.push_back(node);
+        }
+    }
+    if (ok) ok = stack.empty() && keyOffset == keys.size() && position == shape.size();
+
+    if (!ok) {
+        std::cerr << "Предупреждение: снимок " << path << " содержит некорректную форму дерева" << std::endl;
+        TreeBuilders::deleteDBTree(root);
+        root = nullptr;
+        return false;
+    }
+
+    t = static_cast<int>(header.degree);
+    addKeys(digest, keys);
+    return true;
+}
@@ -0,0 +1,78 @@
+﻿#ifndef TREE_SNAPSHOT_H
+#define TREE_SNAPSHOT_H
+
+#include "tree_node.h"
+#include "db_node.h"
+#include "tree_digest.h"
+#include <string>
+
+/**
+ * @file tree_snapshot.h
+ * @brief Двоичные снимки деревьев: сохранение и загрузка без перестроения
+ *
+ * Построение сбалансированного дерева из ключей стоит O(n log n) сравнений
+ * плюс повороты или разделения. Снимок хранит форму дерева, поэтому
+ * загрузка за один проход O(n) создает узлы в том же порядке и с теми же
+ * связями, без сравнений и балансировки.
+ *
+ * Формат (числа в порядке байт машины, как в FileKeySource):
+ * - заголовок: сигнатура "BSTS", версия, вид дерева (бинарное / ДБД),
+ *   минимальная степень t (для ДБД), число узлов, число ключей,
+ *   размер описания формы в байтах;
+ * - ключи в прямом порядке обхода (pre-order), int32 на ключ;
+ * - форма: для бинарного дерева 2 бита на узел (есть левый, есть правый
+ *   потомок), для ДБД на каждый узел varint (число ключей * 2 + признак листа).
+ *
+ * Итого около 4.25 байта на ключ бинарного дерева. Высоты узлов TreeNode
+ * и уровни DBNode в файл не пишутся, а вычисляются при загрузке: высота -
+ * по поддереву, уровень - как глубина узла.
+ */
+class TreeSnapshot {
+public:
+    /**
+     * @brief Сохранение бинарного дерева (ИСДП, СДП, АВЛ)
+     * @param root Корень дерева (nullptr - пустое дерево)
+     * @param path Путь к файлу (перезаписывается)
+     * @return Размер файла в байтах (-1 при ошибке)
+     */
+    static long long save(TreeNode* root, const std::string& path);
+
+    /**
+     * @brief Сохранение ДБД
+     * @param root Корень дерева (nullptr - пустое дерево)
+     * @param t Минимальная степень, с которой строилось дерево
+     * @param path Путь к файлу (перезаписывается)
+     * @return Размер файла в байтах (-1 при ошибке)
+     */
+    static long long save(DBNode* root, int t, const std::string& path);
+
+    /**
+     * @brief Загрузка бинарного дерева
+     * @param path Путь к файлу
+     * @param root Корень загруженного дерева (nullptr при ошибке)
+     * @param digest Дайджест загруженных ключей (обновляется, если не nullptr)
+     * @return true при успехе
+     *
+     * @note Поле height каждого узла восстанавливается (высота поддерева,
+     *       лист - 1), так что загруженное АВЛ-дерево можно сразу менять
+     *       insertAVL и removeAVL.
+     */
+    static bool load(const std::string& path, TreeNode*& root, TreeDigest* digest = nullptr);
+
+    /**
+     * @brief Загрузка ДБД
+     * @param path Путь к файлу
+     * @param root Корень загруженного дерева (nullptr при ошибке)
+     * @param t Минимальная степень из снимка
+     * @param digest Дайджест загруженных ключей (обновляется, если не nullptr)
+     * @return true при успехе
+     *
+     * @note Поле level не хранится в снимке: при загрузке оно нормализуется
+     *       к глубине узла (корень - 0). Вставка и удаление в ДБД держат
+     *       level равным глубине, поэтому для таких деревьев это совпадает
+     *       с сохраненным значением; иное значение level не восстанавливается.
+     */
+    static bool load(const std::string& path, DBNode*& root, int& t, TreeDigest* digest = nullptr);
+};
+
+#endif // TREE_SNAPSHOT_H
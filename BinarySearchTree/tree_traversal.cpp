@@ -0,0 +1,310 @@
+﻿/**
+ * @file tree_traversal.cpp
+ * @brief Реализация ленивых итераторов обхода деревьев
+ */
+
+#include "tree_traversal.h"
+#include <algorithm>
+
+ // ================== Бинарное дерево ==================
+
+ /**
+  * @brief Начало in-order обхода: спуск к самому левому узлу
+  */
+InOrderIterator::InOrderIterator(TreeNode* root) {
+    pushLeftPath(root);
+}
+
+/**
+ * @brief Переход к следующему ключу
+ *
+ * После посещения узла обход продолжается с самого левого узла
+ * его правого поддерева; если его нет - с ближайшего непосещенного предка.
+ */
+InOrderIterator& InOrderIterator::operator++() {
+    TreeNode* node = stack.back();
+    stack.pop_back();
+    pushLeftPath(node->right);
+    return *this;
+}
+
+/**
+ * @brief Спуск по левым указателям с сохранением пути
+ */
+void InOrderIterator::pushLeftPath(TreeNode* node) {
+    while (node != nullptr) {
+        stack.push_back(node);
+        node = node->left;
+    }
+}
+
+/**
+ * @brief Начало pre-order обхода с корня
+ */
+PreOrderIterator::PreOrderIterator(TreeNode* root) {
+    if (root != nullptr) stack.push_back(root);
+}
+
+/**
+ * @brief Переход к следующему ключу
+ *
+ * Потомки кладутся в стек справа налево, чтобы левое поддерево
+ * обходилось первым.
+ */
+PreOrderIterator& PreOrderIterator::operator++() {
+    TreeNode* node = stack.back();
+    stack.pop_back();
+    if (node->right != nullptr) stack.push_back(node->right);
+    if (node->left != nullptr) stack.push_back(node->left);
+    return *this;
+}
+
+/**
+ * @brief Начало обхода по уровням с корня
+ */
+LevelOrderIterator::LevelOrderIterator(TreeNode* root) {
+    if (root != nullptr) queue.push_back(root);
+}
+
+/**
+ * @brief Переход к следующему ключу: потомки текущего узла ставятся в конец очереди
+ */
+LevelOrderIterator& LevelOrderIterator::operator++() {
+    TreeNode* node = queue.front();
+    queue.pop_front();
+    if (node->left != nullptr) queue.push_back(node->left);
+    if (node->right != nullptr) queue.push_back(node->right);
+    return *this;
+}
+
+// ================== ДБД ==================
+
+/**
+ * @brief Начало in-order обхода B-дерева: спуск к самому левому листу
+ */
+DBInOrderIterator::DBInOrderIterator(DBNode* root) {
+    pushLeftPath(root);
+}
+
+/**
+ * @brief Переход к следующему ключу B-дерева
+ *
+ * @details
+ * После ключа keys[i] внутреннего узла следует самый левый ключ поддерева
+ * children[i + 1]. В листе индекс просто сдвигается; исчерпанные узлы
+ * снимаются со стека, открывая очередной ключ предка.
+ */
+DBInOrderIterator& DBInOrderIterator::operator++() {
+    DBPosition& top = stack.back();
+    top.second++;
+
+    if (!top.first->isLeaf) {
+        pushLeftPath(top.first->children[top.second]);
+    }
+
+    while (!stack.empty() && stack.back().second >= stack.back().first->keys.size()) {
+        stack.pop_back();
+    }
+    return *this;
+}
+
+/**
+ * @brief Спуск по первым потомкам с сохранением пути
+ */
+void DBInOrderIterator::pushLeftPath(DBNode* node) {
+    while (node != nullptr) {
+        stack.push_back(DBPosition(node, 0));
+        if (node->isLeaf) break;
+        node = node->children.front();
+    }
+}
+
+/**
+ * @brief Начало pre-order обхода B-дерева с первого ключа корня
+ */
+DBPreOrderIterator::DBPreOrderIterator(DBNode* root) {
+    if (root != nullptr) stack.push_back(DBPosition(root, 0));
+}
+
+/**
+ * @brief Переход к следующему ключу
+ *
+ * Когда ключи узла исчерпаны, узел снимается со стека, а его потомки
+ * кладутся в обратном порядке, чтобы первый потомок обходился первым.
+ */
+DBPreOrderIterator& DBPreOrderIterator::operator++() {
+    DBPosition& top = stack.back();
+    top.second++;
+    if (top.second < top.first->keys.size()) {
+        return *this;
+    }
+
+    DBNode* node = top.first;
+    stack.pop_back();
+    for (auto it = node->children.rbegin(); it != node->children.rend(); ++it) {
+        stack.push_back(DBPosition(*it, 0));
+    }
+    return *this;
+}
+
+/**
+ * @brief Начало обхода B-дерева по уровням с корня
+ */
+DBLevelOrderIterator::DBLevelOrderIterator(DBNode* root) {
+    if (root != nullptr) queue.push_back(root);
+}
+
+/**
+ * @brief Переход к следующему ключу
+ *
+ * Когда ключи узла исчерпаны, его потомки ставятся в конец очереди.
+ */
+DBLevelOrderIterator& DBLevelOrderIterator::operator++() {
+    index++;
+    if (index < queue.front()->keys.size()) {
+        return *this;
+    }
+
+    DBNode* node = queue.front();
+    queue.pop_front();
+    index = 0;
+    for (DBNode* child : node->children) queue.push_back(child);
+    return *this;
+}
+
+// ================== Выборка из обхода ==================
+
+/**
+ * @brief Первые ключи обхода; complete - поместились ли все ключи
+ *
+ * Если не поместились, first укорачивается до edge ключей,
+ * а наименьший ключ дерева возвращается отдельно (при edge == 0 его нет в first).
+ */
+template <typename Node>
+static int sampleFirst(Node* root, int edge, int middle, TraversalSample& sample) {
+    const size_t limit = static_cast<size_t>(2 * edge + middle);
+    for (int key : TreeTraversal::inOrder(root)) {
+        if (sample.first.size() == limit) {
+            sample.complete = false;
+            break;
+        }
+        sample.first.push_back(key);
+    }
+    if (sample.complete) return 0;
+
+    // limit == 0: ни одного ключа не сохранено, наименьший - начало обхода
+    int lowest = sample.first.empty() ? *TreeTraversal::inOrder(root).begin() : sample.first.front();
+    sample.first.resize(edge);
+    return lowest;
+}
+
+/**
+ * @brief Последние count ключей бинарного дерева (в порядке убывания)
+ *
+ * Зеркальный in-order обход: спуск по правым указателям со стеком.
+ */
+static void collectLast(TreeNode* root, size_t count, std::vector<int>& keys) {
+    std::vector<TreeNode*> stack;
+    TreeNode* node = root;
+    while (keys.size() < count && (node != nullptr || !stack.empty())) {
+        while (node != nullptr) {
+            stack.push_back(node);
+            node = node->right;
+        }
+        node = stack.back();
+        stack.pop_back();
+        keys.push_back(node->key);
+        node = node->left;
+    }
+}
+
+/**
+ * @brief Последние count ключей B-дерева (в порядке убывания)
+ *
+ * Рекурсия идет на глубину дерева: ключ keys[i - 1] следует
+ * за поддеревом children[i] при обходе справа налево.
+ */
+static void collectLast(DBNode* node, size_t count, std::vector<int>& keys) {
+    if (node == nullptr) return;
+    for (size_t i = node->keys.size(); i > 0 && keys.size() < count; i--) {
+        if (!node->isLeaf) collectLast(node->children[i], count, keys);
+        if (keys.size() < count) keys.push_back(node->keys[i - 1]);
+    }
+    if (!node->isLeaf && keys.size() < count) collectLast(node->children[0], count, keys);
+}
+
+/**
+ * @brief Наименьший ключ, не меньший target (спуск от корня)
+ */
+static int lowerBoundKey(TreeNode* node, long long target, int fallback) {
+    int found = fallback;
+    while (node != nullptr) {
+        if (node->key >= target) {
+            found = node->key;
+            node = node->left;
+        }
+        else {
+            node = node->right;
+        }
+    }
+    return found;
+}
+
+static int lowerBoundKey(DBNode* node, long long target, int fallback) {
+    int found = fallback;
+    while (node != nullptr) {
+        auto position = std::lower_bound(node->keys.begin(), node->keys.end(), target);
+        size_t index = position - node->keys.begin();
+        if (position != node->keys.end()) found = *position;
+        if (node->isLeaf) break;
+        node = node->children[index];
+    }
+    return found;
+}
+
+/**
+ * @brief Выборка из in-order обхода
+ *
+ * @details
+ * Ключи середины строго возрастают и лежат между first и last: спуск
+ * ищет наименьший ключ, не меньший ни очередной отметки по значению,
+ * ни значения, следующего за уже взятым ключом. Если ключи сгущены,
+ * несколько отметок попадают на одно сгущение, и каждая берет следующий
+ * ключ; выборка заканчивается раньше, если ключи до last исчерпаны.
+ */
+template <typename Node>
+static TraversalSample sampleTree(Node* root, int edge, int middle) {
+    edge = std::max(edge, 0);
+    middle = std::max(middle, 0);
+
+    TraversalSample sample;
+    int lowest = sampleFirst(root, edge, middle, sample);
+    if (sample.complete) return sample;
+
+    std::vector<int> last;
+    collectLast(root, static_cast<size_t>(std::max(edge, 1)), last);
+    int highest = last.front();
+    last.resize(edge);
+    sample.last.assign(last.rbegin(), last.rend());
+
+    long long low = lowest;
+    long long high = highest;
+    long long next = sample.first.empty() ? low : sample.first.back() + 1LL;
+    long long ceiling = sample.last.empty() ? high + 1 : sample.last.front();
+    for (int i = 1; i <= middle && next < ceiling; i++) {
+        long long target = std::max(low + (high - low) * i / (middle + 1), next);
+        int key = lowerBoundKey(root, target, highest);
+        if (key >= ceiling) break;
+        sample.middle.push_back(key);
+        next = key + 1LL;
+    }
+    return sample;
+}
+
+TraversalSample TreeTraversal::sampleInOrder(TreeNode* root, int edge, int middle) {
+    return sampleTree(root, edge, middle);
+}
+
+TraversalSample TreeTraversal::sampleInOrder(DBNode* root, int edge, int middle) {
+    return sampleTree(root, edge, middle);
+}
@@ -0,0 +1,348 @@
+﻿#ifndef TREE_TRAVERSAL_H
+#define TREE_TRAVERSAL_H
+
+#include "tree_node.h"
+#include "db_node.h"
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * @file tree_traversal.h
+ * @brief Ленивые итераторы и посетители для обходов деревьев
+ *
+ * В отличие от TreeProperties::inOrderTraversal и TreeBuilders::inOrderTraversalDB,
+ * итераторы не строят вектор всех ключей: память O(h) для обходов в глубину
+ * и O(ширина уровня) для обхода по уровням. Обход можно прервать в любой момент.
+ *
+ * Пример:
+ * @code
+ * for (int key : TreeTraversal::inOrder(root)) { ... }
+ * TreeTraversal::visitLevelOrder(dbRoot, [](int key) { return key < 100; });
+ * @endcode
+ */
+
+ // ==== Итераторы бинарного дерева ====
+
+ /**
+  * @brief Итератор in-order обхода (левый-корень-правый)
+  */
+class InOrderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    InOrderIterator() = default;
+    explicit InOrderIterator(TreeNode* root);
+
+    reference operator*() const { return stack.back()->key; }
+    pointer operator->() const { return &stack.back()->key; }
+    InOrderIterator& operator++();
+    InOrderIterator operator++(int) { InOrderIterator old = *this; ++*this; return old; }
+
+    bool operator==(const InOrderIterator& other) const {
+        return stack.empty() ? other.stack.empty()
+            : !other.stack.empty() && stack.back() == other.stack.back();
+    }
+    bool operator!=(const InOrderIterator& other) const { return !(*this == other); }
+
+private:
+    void pushLeftPath(TreeNode* node);
+
+    std::vector<TreeNode*> stack; // Путь к текущему узлу (только непосещенные предки)
+};
+
+/**
+ * @brief Итератор pre-order обхода (корень-левый-правый)
+ */
+class PreOrderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    PreOrderIterator() = default;
+    explicit PreOrderIterator(TreeNode* root);
+
+    reference operator*() const { return stack.back()->key; }
+    pointer operator->() const { return &stack.back()->key; }
+    PreOrderIterator& operator++();
+    PreOrderIterator operator++(int) { PreOrderIterator old = *this; ++*this; return old; }
+
+    bool operator==(const PreOrderIterator& other) const {
+        return stack.empty() ? other.stack.empty()
+            : !other.stack.empty() && stack.back() == other.stack.back();
+    }
+    bool operator!=(const PreOrderIterator& other) const { return !(*this == other); }
+
+private:
+    std::vector<TreeNode*> stack; // Текущий узел на вершине, ниже - отложенные правые поддеревья
+};
+
+/**
+ * @brief Итератор обхода по уровням (в ширину)
+ */
+class LevelOrderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    LevelOrderIterator() = default;
+    explicit LevelOrderIterator(TreeNode* root);
+
+    reference operator*() const { return queue.front()->key; }
+    pointer operator->() const { return &queue.front()->key; }
+    LevelOrderIterator& operator++();
+    LevelOrderIterator operator++(int) { LevelOrderIterator old = *this; ++*this; return old; }
+
+    bool operator==(const LevelOrderIterator& other) const {
+        return queue.empty() ? other.queue.empty()
+            : !other.queue.empty() && queue.front() == other.queue.front();
+    }
+    bool operator!=(const LevelOrderIterator& other) const { return !(*this == other); }
+
+private:
+    std::deque<TreeNode*> queue; // Текущий узел в начале очереди
+};
+
+// ==== Итераторы B-дерева (ДБД) ====
+
+/**
+ * @brief Позиция в узле B-дерева: узел и индекс текущего ключа
+ */
+using DBPosition = std::pair<DBNode*, std::size_t>;
+
+/**
+ * @brief Итератор in-order обхода B-дерева (ключи по возрастанию)
+ */
+class DBInOrderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    DBInOrderIterator() = default;
+    explicit DBInOrderIterator(DBNode* root);
+
+    reference operator*() const { return stack.back().first->keys[stack.back().second]; }
+    pointer operator->() const { return &**this; }
+    DBInOrderIterator& operator++();
+    DBInOrderIterator operator++(int) { DBInOrderIterator old = *this; ++*this; return old; }
+
+    bool operator==(const DBInOrderIterator& other) const {
+        return stack.empty() ? other.stack.empty()
+            : !other.stack.empty() && stack.back() == other.stack.back();
+    }
+    bool operator!=(const DBInOrderIterator& other) const { return !(*this == other); }
+
+private:
+    void pushLeftPath(DBNode* node);
+
+    std::vector<DBPosition> stack; // Путь к текущему ключу
+};
+
+/**
+ * @brief Итератор pre-order обхода B-дерева (ключи узла, затем поддеревья слева направо)
+ */
+class DBPreOrderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    DBPreOrderIterator() = default;
+    explicit DBPreOrderIterator(DBNode* root);
+
+    reference operator*() const { return stack.back().first->keys[stack.back().second]; }
+    pointer operator->() const { return &**this; }
+    DBPreOrderIterator& operator++();
+    DBPreOrderIterator operator++(int) { DBPreOrderIterator old = *this; ++*this; return old; }
+
+    bool operator==(const DBPreOrderIterator& other) const {
+        return stack.empty() ? other.stack.empty()
+            : !other.stack.empty() && stack.back() == other.stack.back();
+    }
+    bool operator!=(const DBPreOrderIterator& other) const { return !(*this == other); }
+
+private:
+    std::vector<DBPosition> stack; // Текущий ключ на вершине, ниже - отложенные поддеревья
+};
+
+/**
+ * @brief Итератор обхода B-дерева по уровням (ключи узлов в порядке обхода в ширину)
+ */
+class DBLevelOrderIterator {
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    DBLevelOrderIterator() = default;
+    explicit DBLevelOrderIterator(DBNode* root);
+
+    reference operator*() const { return queue.front()->keys[index]; }
+    pointer operator->() const { return &**this; }
+    DBLevelOrderIterator& operator++();
+    DBLevelOrderIterator operator++(int) { DBLevelOrderIterator old = *this; ++*this; return old; }
+
+    bool operator==(const DBLevelOrderIterator& other) const {
+        return queue.empty() ? other.queue.empty()
+            : !other.queue.empty() && queue.front() == other.queue.front() && index == other.index;
+    }
+    bool operator!=(const DBLevelOrderIterator& other) const { return !(*this == other); }
+
+private:
+    std::deque<DBNode*> queue; // Текущий узел в начале очереди
+    std::size_t index = 0;     // Индекс текущего ключа в узле
+};
+
+// ==== Выборка из обхода ====
+
+/**
+ * @brief Выборка ключей in-order обхода для краткого вывода
+ *
+ * Для небольшого дерева (не больше 2 * edge + middle ключей) complete == true,
+ * и все ключи лежат в first. Иначе first и last - крайние ключи,
+ * middle - строго возрастающие ключи между ними, распределенные по значению
+ * (при сгущенных ключах их может быть меньше запрошенного).
+ */
+struct TraversalSample {
+    std::vector<int> first;   // Наименьшие ключи по возрастанию
+    std::vector<int> middle;  // Ключи из середины по возрастанию
+    std::vector<int> last;    // Наибольшие ключи по возрастанию
+    bool complete = true;     // first содержит все ключи дерева
+};
+
+// ==== Диапазоны и посетители ====
+
+/**
+ * @brief Диапазон для range-based for: [begin, конец обхода)
+ */
+template <typename Iterator>
+class TraversalRange {
+public:
+    explicit TraversalRange(Iterator first) : first(first) {}
+    Iterator begin() const { return first; }
+    Iterator end() const { return Iterator(); }
+
+private:
+    Iterator first;
+};
+
+class TreeTraversal {
+public:
+    /**
+     * @brief Ленивый in-order обход
+     * @param root Корень дерева
+     * @return Диапазон ключей в порядке возрастания
+     */
+    static TraversalRange<InOrderIterator> inOrder(TreeNode* root) {
+        return TraversalRange<InOrderIterator>(InOrderIterator(root));
+    }
+    static TraversalRange<DBInOrderIterator> inOrder(DBNode* root) {
+        return TraversalRange<DBInOrderIterator>(DBInOrderIterator(root));
+    }
+
+    /**
+     * @brief Ленивый pre-order обход
+     * @param root Корень дерева
+     * @return Диапазон ключей в прямом порядке
+     */
+    static TraversalRange<PreOrderIterator> preOrder(TreeNode* root) {
+        return TraversalRange<PreOrderIterator>(PreOrderIterator(root));
+    }
+    static TraversalRange<DBPreOrderIterator> preOrder(DBNode* root) {
+        return TraversalRange<DBPreOrderIterator>(DBPreOrderIterator(root));
+    }
+
+    /**
+     * @brief Ленивый обход по уровням
+     * @param root Корень дерева
+     * @return Диапазон ключей по уровням сверху вниз, слева направо
+     */
+    static TraversalRange<LevelOrderIterator> levelOrder(TreeNode* root) {
+        return TraversalRange<LevelOrderIterator>(LevelOrderIterator(root));
+    }
+    static TraversalRange<DBLevelOrderIterator> levelOrder(DBNode* root) {
+        return TraversalRange<DBLevelOrderIterator>(DBLevelOrderIterator(root));
+    }
+
+    /**
+     * @brief Выборка из in-order обхода без построения вектора всех ключей
+     * @param root Корень дерева
+     * @param edge Сколько наименьших и наибольших ключей взять
+     * @param middle Сколько ключей взять из середины
+     * @return Выборка (см. TraversalSample)
+     *
+     * @details
+     * Первые ключи берутся итератором, последние - обходом в обратном
+     * порядке, ключи середины - спуском от корня к наименьшему ключу,
+     * не меньшему min + (max - min) * i / (middle + 1). Посещается
+     * O(edge + middle * h) узлов, где h - высота дерева: размер поддеревьев
+     * в узлах не хранится, поэтому середина делится по значениям ключей,
+     * а не по их номерам. Каждый следующий ключ середины больше предыдущего,
+     * повторов нет. Отрицательные edge и middle считаются нулем.
+     */
+    static TraversalSample sampleInOrder(TreeNode* root, int edge = 5, int middle = 5);
+    static TraversalSample sampleInOrder(DBNode* root, int edge = 5, int middle = 5);
+
+    /**
+     * @brief In-order обход с посетителем
+     * @param root Корень дерева (TreeNode* или DBNode*)
+     * @param visit Функция bool(int key); false прерывает обход
+     * @return true если обход дошел до конца
+     */
+    template <typename Node, typename Visitor>
+    static bool visitInOrder(Node* root, Visitor visit) {
+        return visitRange(inOrder(root), visit);
+    }
+
+    /**
+     * @brief Pre-order обход с посетителем
+     * @param root Корень дерева (TreeNode* или DBNode*)
+     * @param visit Функция bool(int key); false прерывает обход
+     * @return true если обход дошел до конца
+     */
+    template <typename Node, typename Visitor>
+    static bool visitPreOrder(Node* root, Visitor visit) {
+        return visitRange(preOrder(root), visit);
+    }
+
+    /**
+     * @brief Обход по уровням с посетителем
+     * @param root Корень дерева (TreeNode* или DBNode*)
+     * @param visit Функция bool(int key); false прерывает обход
+     * @return true если обход дошел до конца
+     */
+    template <typename Node, typename Visitor>
+    static bool visitLevelOrder(Node* root, Visitor visit) {
+        return visitRange(levelOrder(root), visit);
+    }
+
+private:
+    template <typename Range, typename Visitor>
+    static bool visitRange(const Range& range, Visitor& visit) {
+        for (int key : range) {
+            if (!visit(key)) return false;
+        }
+        return true;
+    }
+};
+
+#endif // TREE_TRAVERSAL_H
@@ -0,0 +1,416 @@
+﻿/**
+ * @file workload.cpp
+ * @brief Генерация, хранение и воспроизведение трасс операций
+ */
+
+#include "workload.h"
+#include "tree_builders.h"
+#include "tree_properties.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <set>
+
+// Сигнатура и версия формата файла трассы
+static const char TRACE_MAGIC[4] = { 'B', 'S', 'T', 'W' };
+static const unsigned int TRACE_VERSION = 1;
+
+// ================== Кодирование ==================
+
+static void writeVarint(std::vector<unsigned char>& out, unsigned long long value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<unsigned char>(value));
+}
+
+// zigzag: малые по модулю числа (в том числе отрицательные) - короткие varint
+static void writeSigned(std::vector<unsigned char>& out, long long value) {
+    writeVarint(out, (static_cast<unsigned long long>(value) << 1) ^ static_cast<unsigned long long>(value >> 63));
+}
+
+static void writeDelta(std::vector<unsigned char>& out, int previous, int key) {
+    writeSigned(out, static_cast<long long>(key) - previous);
+}
+
+/**
+ * @brief Последовательное чтение буфера файла трассы
+ */
+class TraceReader {
+public:
+    explicit TraceReader(const std::vector<unsigned char>& data) : data(data), position(0), failed(false) {}
+
+    bool readVarint(unsigned long long& value) {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (position >= data.size()) return fail();
+            unsigned char byte = data[position++];
+            value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return fail();
+    }
+
+    bool readSigned(long long& value) {
+        unsigned long long encoded;
+        if (!readVarint(encoded)) return false;
+        value = static_cast<long long>(encoded >> 1) ^ -static_cast<long long>(encoded & 1);
+        return true;
+    }
+
+    bool readDelta(int previous, int& key) {
+        long long delta;
+        if (!readSigned(delta)) return false;
+        key = static_cast<int>(previous + delta);
+        return true;
+    }
+
+    bool readByte(unsigned char& byte) {
+        if (position >= data.size()) return fail();
+        byte = data[position++];
+        return true;
+    }
+
+    bool readBytes(void* out, size_t size) {
+        if (position + size > data.size()) return fail();
+        std::memcpy(out, data.data() + position, size);
+        position += size;
+        return true;
+    }
+
+    bool ok() const { return !failed; }
+
+    bool fail() {
+        failed = true;
+        return false;
+    }
+
+private:
+    const std::vector<unsigned char>& data;
+    size_t position;
+    bool failed;
+};
+
+// ================== Генерация ==================
+
+/**
+ * @brief Генерация трассы
+ *
+ * @details
+ * Текущий набор ключей ведется в std::set (генерация не замеряется).
+ * Поток значений формы spec.distribution задает, куда направлена операция:
+ * вставка берет ближайшее свободное значение от него вверх, остальные
+ * операции - ближайший существующий ключ (по кругу). Вид операции
+ * выбирается по смеси отдельным генератором.
+ */
+Trace Workload::generate(const WorkloadSpec& spec) {
+    Trace trace;
+    unsigned long long seed = DataGenerator::resolveSeed(spec.seed);
+
+    long long range = 10LL * (std::max(spec.initialKeys, 0) + std::max(spec.operationCount, 0)) + 10;
+    int maxVal = static_cast<int>(std::min<long long>(range, 2000000000LL));
+
+    trace.initialKeys = DataGenerator::generateUniqueNumbers(spec.initialKeys, 1, maxVal, seed);
+    std::set<int> live(trace.initialKeys.begin(), trace.initialKeys.end());
+
+    std::vector<int> targets = DataGenerator::generateKeys(spec.distribution, spec.operationCount, 1, maxVal, seed + 1);
+    if (targets.empty()) targets.push_back(1);
+
+    const WorkloadMix& mix = spec.mix;
+    int total = mix.insertPercent + mix.searchPercent + mix.deletePercent + mix.rangePercent;
+    if (total <= 0) {
+        std::cerr << "Предупреждение: пустая смесь операций, трасса без операций" << std::endl;
+        return trace;
+    }
+    std::mt19937_64 gen(seed + 2);
+    std::uniform_int_distribution<int> percent(0, total - 1);
+
+    trace.operations.reserve(spec.operationCount);
+    for (int i = 0; i < spec.operationCount; ++i) {
+        int target = targets[i % targets.size()];
+        int roll = percent(gen);
+
+        Operation op;
+        op.length = 0;
+        if (roll < mix.insertPercent || live.empty()) {
+            // Ближайшее свободное значение от target вверх (по кругу)
+            int key = target;
+            while (live.count(key)) key = key == maxVal ? 1 : key + 1;
+            live.insert(key);
+            op.type = OperationType::Insert;
+            op.key = key;
+        }
+        else {
+            auto it = live.lower_bound(target);
+            if (it == live.end()) it = live.begin();
+            op.key = *it;
+
+            roll -= mix.insertPercent;
+            if (roll < mix.searchPercent) {
+                op.type = OperationType::Search;
+            }
+            else if (roll < mix.searchPercent + mix.deletePercent) {
+                op.type = OperationType::Delete;
+                live.erase(it);
+            }
+            else {
+                op.type = OperationType::Range;
+                op.length = std::max(spec.rangeLength, 0);
+            }
+        }
+        trace.operations.push_back(op);
+    }
+
+    for (int key : live) trace.expected.add(key);
+    return trace;
+}
+
+// ================== Файл трассы ==================
+
+/**
+ * @brief Сохранение трассы в двоичный файл
+ *
+ * Файл собирается в буфере и пишется одним вызовом fwrite.
+ */
+long long Workload::save(const Trace& trace, const std::string& path) {
+    std::vector<unsigned char> out(TRACE_MAGIC, TRACE_MAGIC + 4);
+    writeVarint(out, TRACE_VERSION);
+
+    writeSigned(out, trace.expected.checkSum);
+    writeVarint(out, trace.expected.fingerprint);
+    writeVarint(out, static_cast<unsigned long long>(trace.expected.count));
+
+    writeVarint(out, trace.initialKeys.size());
+    writeVarint(out, trace.operations.size());
+
+    int previous = 0;
+    for (int key : trace.initialKeys) {
+        writeDelta(out, previous, key);
+        previous = key;
+    }
+
+    previous = 0;
+    for (const Operation& op : trace.operations) {
+        out.push_back(static_cast<unsigned char>(op.type));
+        writeDelta(out, previous, op.key);
+        previous = op.key;
+        if (op.type == OperationType::Range) writeVarint(out, static_cast<unsigned int>(op.length));
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось создать файл трассы " << path << std::endl;
+        return -1;
+    }
+    size_t written = std::fwrite(out.data(), 1, out.size(), file);
+    std::fclose(file);
+    return written == out.size() ? static_cast<long long>(written) : -1;
+}
+
+/**
+ * @brief Загрузка трассы из двоичного файла
+ */
+bool Workload::load(const std::string& path, Trace& trace) {
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file) {
+        std::cerr << "Предупреждение: не удалось открыть файл трассы " << path << std::endl;
+        return false;
+    }
+    std::vector<unsigned char> data;
+    unsigned char buffer[1 << 16];
+    size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        data.insert(data.end(), buffer, buffer + read);
+    }
+    std::fclose(file);
+
+    TraceReader reader(data);
+    char magic[4];
+    unsigned long long version, initialCount, operationCount;
+    if (!reader.readBytes(magic, 4) || std::memcmp(magic, TRACE_MAGIC, 4) != 0 ||
+        !reader.readVarint(version) || version != TRACE_VERSION) {
+        std::cerr << "Предупреждение: " << path << " не является файлом трассы" << std::endl;
+        return false;
+    }
+
+    trace = Trace();
+    unsigned long long count;
+    reader.readSigned(trace.expected.checkSum);
+    reader.readVarint(trace.expected.fingerprint);
+    reader.readVarint(count);
+    trace.expected.count = static_cast<long long>(count);
+    reader.readVarint(initialCount);
+    reader.readVarint(operationCount);
+    if (!reader.ok() || initialCount > data.size() || operationCount > data.size()) {
+        std::cerr << "Предупреждение: поврежденный заголовок трассы " << path << std::endl;
+        return false;
+    }
+
+    trace.initialKeys.resize(static_cast<size_t>(initialCount));
+    int previous = 0;
+    for (int& key : trace.initialKeys) {
+        if (!reader.readDelta(previous, key)) break;
+        previous = key;
+    }
+
+    trace.operations.resize(static_cast<size_t>(operationCount));
+    previous = 0;
+    for (Operation& op : trace.operations) {
+        unsigned char type;
+        if (!reader.readByte(type) || type >= OPERATION_TYPE_COUNT) {
+            reader.fail();
+            break;
+        }
+        op.type = static_cast<OperationType>(type);
+        if (!reader.readDelta(previous, op.key)) break;
+        previous = op.key;
+        op.length = 0;
+        if (op.type == OperationType::Range) {
+            unsigned long long length;
+            if (!reader.readVarint(length)) break;
+            op.length = static_cast<int>(length);
+        }
+    }
+
+    if (!reader.ok()) {
+        std::cerr << "Предупреждение: файл трассы " << path << " обрезан или поврежден" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// ================== Воспроизведение ==================
+
+/**
+ * @brief Медиана, 99-й перцентиль и максимум задержек
+ */
+static OperationLatency summarize(std::vector<double>& samples) {
+    OperationLatency result;
+    result.count = static_cast<long long>(samples.size());
+    if (samples.empty()) return result;
+
+    size_t p50 = samples.size() / 2;
+    size_t p99 = std::min(samples.size() - 1, samples.size() * 99 / 100);
+    std::nth_element(samples.begin(), samples.begin() + p50, samples.end());
+    result.p50Ns = samples[p50];
+    std::nth_element(samples.begin(), samples.begin() + p99, samples.end());
+    result.p99Ns = samples[p99];
+    result.maxNs = *std::max_element(samples.begin() + p99, samples.end());
+    return result;
+}
+
+/**
+ * @brief Воспроизведение трассы на дереве заданного вида
+ *
+ * @details
+ * Начальные ключи вставляются построителем вида (для ИСДП - по
+ * отсортированной копии). Каждая операция замеряется отдельно по
+ * steady_clock; в задержку входит и сам замер (десятки нс).
+ */
+ReplayResult Workload::replay(const Trace& trace, TreeKind kind) {
+    const int t = 2;
+    ReplayResult result;
+    TreeNode* tree = nullptr;
+    DBNode* dbTree = nullptr;
+
+    switch (kind) {
+    case TreeKind::PerfectlyBalanced: {
+        std::vector<int> sorted = trace.initialKeys;
+        std::sort(sorted.begin(), sorted.end());
+        tree = TreeBuilders::buildPerfectlyBalancedTree(sorted, &result.digest);
+        break;
+    }
+    case TreeKind::RandomSearch:
+        for (int key : trace.initialKeys) TreeBuilders::insertBST(tree, key, &result.digest);
+        break;
+    case TreeKind::AVL:
+        tree = TreeBuilders::buildAVLTree(trace.initialKeys, &result.digest);
+        break;
+    case TreeKind::DB:
+        dbTree = TreeBuilders::buildDBTree(trace.initialKeys, t, &result.digest);
+        break;
+    }
+
+    std::vector<double> samples[OPERATION_TYPE_COUNT];
+    std::vector<int> rangeKeys;
+    bool binary = kind != TreeKind::DB;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const Operation& op : trace.operations) {
+        auto opStart = std::chrono::steady_clock::now();
+        switch (op.type) {
+        case OperationType::Insert:
+            if (kind == TreeKind::AVL) tree = TreeBuilders::insertAVL(tree, op.key, &result.digest);
+            else if (binary) TreeBuilders::insertBST(tree, op.key, &result.digest);
+            else TreeBuilders::insertDBNode(dbTree, op.key, t, 0, &result.digest);
+            break;
+        case OperationType::Search:
+            if (binary ? TreeProperties::searchNode(tree, op.key) != nullptr
+                       : TreeProperties::searchNodeDB(dbTree, op.key) != nullptr) {
+                result.hits++;
+            }
+            break;
+        case OperationType::Delete:
+            if (kind == TreeKind::AVL) tree = TreeBuilders::removeAVL(tree, op.key, &result.digest);
+            else if (binary) TreeBuilders::removeBST(tree, op.key, &result.digest);
+            else TreeBuilders::removeDBNode(dbTree, op.key, t, &result.digest);
+            break;
+        case OperationType::Range: {
+            rangeKeys.clear();
+            long long high = std::min<long long>(static_cast<long long>(op.key) + op.length, 2147483647LL);
+            if (binary) TreeProperties::rangeQuery(tree, op.key, static_cast<int>(high), rangeKeys);
+            else TreeProperties::rangeQueryDB(dbTree, op.key, static_cast<int>(high), rangeKeys);
+            result.hits += static_cast<long long>(rangeKeys.size());
+            break;
+        }
+        }
+        auto opFinish = std::chrono::steady_clock::now();
+        samples[static_cast<int>(op.type)].push_back(
+            std::chrono::duration<double, std::nano>(opFinish - opStart).count());
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    result.seconds = std::chrono::duration<double>(finish - start).count();
+    if (result.seconds > 0) result.operationsPerSecond = trace.operations.size() / result.seconds;
+    for (int i = 0; i < OPERATION_TYPE_COUNT; ++i) result.latency[i] = summarize(samples[i]);
+
+    if (result.digest != trace.expected) {
+        std::cerr << "Предупреждение: после трассы " << treeKindName(kind)
+            << " содержит не тот набор ключей, что ожидался!" << std::endl;
+    }
+
+    TreeBuilders::deleteTree(tree);
+    TreeBuilders::deleteDBTree(dbTree);
+    return result;
+}
+
+/**
+ * @brief Название вида дерева для вывода
+ */
+const char* Workload::treeKindName(TreeKind kind) {
+    switch (kind) {
+    case TreeKind::PerfectlyBalanced: return "ИСДП";
+    case TreeKind::RandomSearch:      return "СДП";
+    case TreeKind::AVL:               return "АВЛ";
+    case TreeKind::DB:                return "ДБД";
+    }
+    return "?";
+}
+
+/**
+ * @brief Название вида операции для вывода
+ */
+const char* Workload::operationName(OperationType type) {
+    switch (type) {
+    case OperationType::Insert: return "вставка";
+    case OperationType::Search: return "поиск";
+    case OperationType::Delete: return "удаление";
+    case OperationType::Range:  return "диапазон";
+    }
+    return "?";
+}
@@ -0,0 +1,159 @@
+﻿#ifndef WORKLOAD_H
+#define WORKLOAD_H
+
+#include "data_generator.h"
+#include "tree_digest.h"
+#include <string>
+#include <vector>
+
+/**
+ * @file workload.h
+ * @brief Трассы смешанных операций и их воспроизведение на деревьях
+ *
+ * Трасса - начальный набор ключей и последовательность операций вставки,
+ * поиска, удаления и запроса диапазона. Трассу можно сгенерировать по
+ * заданной смеси и форме ключей, сохранить в компактный двоичный файл
+ * и воспроизвести на любом виде дерева из TreeBuilders.
+ */
+
+/**
+ * @brief Вид операции трассы
+ */
+enum class OperationType : unsigned char {
+    Insert = 0,
+    Search = 1,
+    Delete = 2,
+    Range = 3
+};
+
+/// Количество видов операций
+const int OPERATION_TYPE_COUNT = 4;
+
+/**
+ * @brief Операция трассы
+ */
+struct Operation {
+    OperationType type;
+    int key;        ///< Ключ (для Range - нижняя граница)
+    int length;     ///< Для Range: верхняя граница key + length, иначе 0
+};
+
+/**
+ * @brief Смесь операций в процентах (сумма обычно 100)
+ */
+struct WorkloadMix {
+    int insertPercent;
+    int searchPercent;
+    int deletePercent;
+    int rangePercent;
+};
+
+/**
+ * @brief Параметры генерации трассы
+ */
+struct WorkloadSpec {
+    int initialKeys = 10000;                                   ///< Ключей до начала операций
+    int operationCount = 100000;                               ///< Количество операций
+    WorkloadMix mix = { 5, 95, 0, 0 };                         ///< Смесь операций
+    KeyDistribution distribution = KeyDistribution::Uniform;   ///< Форма ключей операций
+    int rangeLength = 100;                                     ///< Ширина запроса диапазона
+    unsigned long long seed = 0;                               ///< Зерно (0 - случайное)
+};
+
+/**
+ * @brief Трасса операций
+ */
+struct Trace {
+    std::vector<int> initialKeys;       ///< Ключи, вставляемые до операций
+    std::vector<Operation> operations;  ///< Операции в порядке выполнения
+    TreeDigest expected;                ///< Дайджест набора ключей после всех операций
+};
+
+/**
+ * @brief Вид дерева для воспроизведения
+ */
+enum class TreeKind {
+    PerfectlyBalanced,  ///< ИСДП (после построения - вставки и удаления без балансировки)
+    RandomSearch,       ///< СДП
+    AVL,                ///< АВЛ-дерево
+    DB                  ///< ДБД с t = 2
+};
+
+/**
+ * @brief Задержки операций одного вида
+ */
+struct OperationLatency {
+    long long count = 0;    ///< Выполнено операций
+    double p50Ns = 0.0;     ///< Медиана, нс
+    double p99Ns = 0.0;     ///< 99-й перцентиль, нс
+    double maxNs = 0.0;     ///< Максимум, нс
+};
+
+/**
+ * @brief Результат воспроизведения трассы
+ */
+struct ReplayResult {
+    double seconds = 0.0;                                   ///< Время операций (без начального построения)
+    double operationsPerSecond = 0.0;                       ///< Пропускная способность
+    OperationLatency latency[OPERATION_TYPE_COUNT];         ///< Задержки по видам операций
+    long long hits = 0;                                     ///< Найдено ключей (поиск и диапазоны)
+    TreeDigest digest;                                      ///< Дайджест дерева после трассы
+};
+
+class Workload {
+public:
+    /**
+     * @brief Генерация трассы
+     * @param spec Параметры генерации
+     * @return Трасса
+     *
+     * @note Вставляются только отсутствующие ключи; поиск, удаление и диапазоны
+     *       берут существующий ключ, ближайший сверху к значению из потока
+     *       ключей формы spec.distribution. Для Zipf часть ключей горячая.
+     */
+    static Trace generate(const WorkloadSpec& spec);
+
+    /**
+     * @brief Сохранение трассы в двоичный файл
+     * @param trace Трасса
+     * @param path Путь к файлу
+     * @return Размер файла в байтах (-1 при ошибке)
+     *
+     * @note Формат: сигнатура, дайджест, затем ключи как zigzag-varint
+     *       разностей с предыдущим ключом; у операции еще байт вида
+     *       и varint ширины диапазона. Около 4 байт на операцию,
+     *       до 5 при преобладании запросов диапазона.
+     */
+    static long long save(const Trace& trace, const std::string& path);
+
+    /**
+     * @brief Загрузка трассы из двоичного файла
+     * @param path Путь к файлу
+     * @param trace Загруженная трасса
+     * @return true при успехе
+     */
+    static bool load(const std::string& path, Trace& trace);
+
+    /**
+     * @brief Воспроизведение трассы на дереве заданного вида
+     * @param trace Трасса
+     * @param kind Вид дерева
+     * @return Время, пропускная способность, задержки и дайджест результата
+     *
+     * @note Выводит предупреждение, если итоговый набор ключей не совпал
+     *       с ожидаемым дайджестом трассы.
+     */
+    static ReplayResult replay(const Trace& trace, TreeKind kind);
+
+    /**
+     * @brief Название вида дерева для вывода
+     */
+    static const char* treeKindName(TreeKind kind);
+
+    /**
+     * @brief Название вида операции для вывода
+     */
+    static const char* operationName(OperationType type);
+};
+
+#endif // WORKLOAD_H